@@ -0,0 +1,76 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "BakedArray.hpp"
+#include "NavFile.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace gabe {
+//Rows of items stored back to back in one array, with the offset of every row in another (compressed sparse rows).
+//Items are staged with add in any order while the owner is being built; finalize lays them out, keeping the items of
+//a row ordered by the given key and, between equal keys, in the order they were added
+template <typename T> class Adjacency {
+public:
+  Adjacency() = default;
+  Adjacency(Adjacency const&) = default;
+  Adjacency(Adjacency&&) noexcept = default;
+
+  auto operator=(Adjacency const&) -> Adjacency& = default;
+  auto operator=(Adjacency&&) noexcept -> Adjacency& = default;
+
+  auto add(Size row, T item) -> void { _staged.emplace_back(row, std::move(item)); }
+
+  auto finalize(Size rowCount) -> void { finalize(rowCount, [](T const&) { return 0; }); }
+
+  template <typename Key> auto finalize(Size rowCount, Key key) -> void {
+    std::ranges::stable_sort(_staged, [&key](auto const& first, auto const& second) {
+      return std::pair {first.first, key(first.second)} < std::pair {second.first, key(second.second)};
+    });
+    std::vector<uint32> offsets(rowCount + 1, 0);
+    std::vector<T> items {};
+    items.reserve(_staged.size());
+    for (auto& [row, item] : _staged) {
+      ++offsets[row + 1];
+      items.push_back(std::move(item));
+    }
+    for (Size row = 0; row < rowCount; ++row) {
+      offsets[row + 1] += offsets[row];
+    }
+    _offsets = BakedArray {std::move(offsets)};
+    _items = BakedArray {std::move(items)};
+    _staged = {};
+  }
+
+  [[nodiscard]] auto operator[](Size row) const -> std::span<T const> {
+    return _items.items().subspan(_offsets[row], _offsets[row + 1] - _offsets[row]);
+  }
+
+  [[nodiscard]] auto rows() const -> Size { return _offsets.empty() ? 0 : _offsets.size() - 1; }
+
+  auto write(nav::Writer& writer) const -> void {
+    writer.array(_offsets);
+    writer.array(_items);
+  }
+
+  static auto read(nav::Reader& reader, Size rowCount) -> Adjacency {
+    Adjacency rez {};
+    rez._offsets = reader.array<uint32>();
+    rez._items = reader.array<T>();
+    reader.expect(rez._offsets.size() == rowCount + 1 && rez._offsets[0] == 0
+                  && std::ranges::is_sorted(rez._offsets.items()) && rez._offsets[rowCount] == rez._items.size());
+    return rez;
+  }
+
+private:
+  BakedArray<uint32> _offsets {};
+  BakedArray<T> _items {};
+  std::vector<std::pair<Size, T>> _staged {};
+};
+} // namespace gabe
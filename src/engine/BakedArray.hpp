@@ -0,0 +1,70 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "types.hpp"
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace gabe {
+//Items of a table baked into a map: owned when the map was compiled in this process, or read in place from the
+//mapping of a navigation file, which must then outlive the array. Copies of a borrowed array borrow the same items;
+//writing through mutableItems copies borrowed items first
+template <typename T> class BakedArray {
+public:
+  BakedArray() = default;
+  BakedArray(BakedArray const& other) :
+      _owned {other._owned}, _items {other._borrowed ? other._items : std::span<T const> {_owned}},
+      _borrowed {other._borrowed} {}
+  BakedArray(BakedArray&& other) noexcept :
+      _owned {std::move(other._owned)}, _items {std::exchange(other._items, {})},
+      _borrowed {std::exchange(other._borrowed, false)} {}
+
+  explicit BakedArray(std::vector<T>&& items) : _owned {std::move(items)}, _items {_owned} {}
+
+  static auto borrow(std::span<T const> items) -> BakedArray {
+    BakedArray rez {};
+    rez._items = items;
+    rez._borrowed = true;
+    return rez;
+  }
+
+  auto operator=(BakedArray const& other) -> BakedArray& {
+    if (this != &other) {
+      _owned = other._owned;
+      _items = other._borrowed ? other._items : std::span<T const> {_owned};
+      _borrowed = other._borrowed;
+    }
+    return *this;
+  }
+
+  auto operator=(BakedArray&& other) noexcept -> BakedArray& {
+    _owned = std::move(other._owned);
+    _items = std::exchange(other._items, {});
+    _borrowed = std::exchange(other._borrowed, false);
+    return *this;
+  }
+
+  [[nodiscard]] auto operator[](Size idx) const -> T const& { return _items[idx]; }
+  [[nodiscard]] auto items() const -> std::span<T const> { return _items; }
+  [[nodiscard]] auto size() const -> Size { return _items.size(); }
+  [[nodiscard]] auto empty() const -> bool { return _items.empty(); }
+
+  [[nodiscard]] auto mutableItems() -> std::span<T> {
+    if (_borrowed) {
+      _owned.assign(_items.begin(), _items.end());
+      _items = _owned;
+      _borrowed = false;
+    }
+    return _owned;
+  }
+
+private:
+  std::vector<T> _owned {};
+  std::span<T const> _items {};
+  bool _borrowed {false};
+};
+} // namespace gabe
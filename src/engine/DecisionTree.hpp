@@ -9,11 +9,14 @@
 #include "Movement.hpp"
 #include "Path.hpp"
 #include "event/Event.hpp"
+#include "multithreaded/scheduler/Scheduler.hpp"
 #include "multithreaded/synchronizer/Synchronizer.hpp"
 #include "utils/objectDetection/ObjectDetectionController.hpp"
+#include "utils/random/AliasTable.hpp"
+#include "utils/random/Random.hpp"
+#include "utils/trace/Trace.hpp"
 #include <memory>
 #include <numeric>
-#include <random>
 #include <vector>
 
 namespace gabe {
@@ -54,15 +57,22 @@ public:
       throw exceptions::DecisionAdditionException();
     }
     _children.emplace_back(weight, std::move(decision));
+    _weightsChanged = true;
   }
 
   virtual auto randomDecision() -> Decision& { return emptyDecision; }
-  virtual auto act() -> std::unique_ptr<Event> { return std::make_unique<EmptyEvent>(); }
+  virtual auto act() -> AnyEvent { return EmptyEvent {}; }
   virtual auto postEvaluation() -> void {
     //empty on purpose
   }
 
-  virtual auto evaluate() -> std::unique_ptr<Event> {
+  //runs before the subtree is evaluated; returning false skips it for this tick
+  virtual auto enter() -> bool { return true; }
+
+  virtual auto evaluate() -> AnyEvent {
+    if (!enter()) {
+      return EmptyEvent {};
+    }
     if (_children.empty()) {
       return act();
     }
@@ -71,37 +81,68 @@ public:
     return child.decision->evaluate();
   }
 
+  //state the whole subtree must see ordered against other trees; the engine schedules trees on this
+  [[nodiscard]] auto access() const -> ResourceAccess {
+    auto rez = ownAccess();
+    for (auto const& child : _children) {
+      rez = rez | child.decision->access();
+    }
+    return rez;
+  }
+
+  [[nodiscard]] virtual auto ownAccess() const -> ResourceAccess { return {0, 0}; }
+
 protected:
   auto selectChild() -> Decision& {
-    std::random_device rd {};
-    auto targetValue = std::uniform_real_distribution<float> {}(rd);
-    auto chosenValue = .0f;
-    for (auto& e : _children) {
-      chosenValue += e.weight;
-      if (chosenValue >= targetValue) {
-        return e;
-      }
+    if (_weightsChanged) {
+      rebuildSelection();
+    }
+    auto const chosen = _selection.sample(_generator);
+    return chosen < _children.size() ? _children[chosen] : randomDecision();
+  }
+
+  auto setWeight(Decision& child, float weight) -> void {
+    if (child.weight != weight) {
+      child.weight = weight;
+      _weightsChanged = true;
     }
-    return randomDecision();
   }
 
   GameState& _state;
   std::vector<Decision> _children;
+  utils::random::Xoshiro256 _generator {utils::random::nextStream()};
+
+private:
+  //the last slot holds the probability left over by the children, which falls through to randomDecision
+  auto rebuildSelection() -> void {
+    std::vector<float> weights {};
+    weights.reserve(_children.size() + 1);
+    for (auto const& child : _children) {
+      weights.push_back(child.weight);
+    }
+    weights.push_back(std::max(1.0f - std::accumulate(weights.begin(), weights.end(), .0f), .0f));
+    _selection.rebuild(weights);
+    _weightsChanged = false;
+  }
+
+  utils::random::AliasTable _selection {};
+  bool _weightsChanged {true};
 };
 
+//the enemy is only sampled to delay the subtree, so it is read without being ordered after detection
 template <int iterationDelay> class EnemyDependentTree : public DecisionTree {
 public:
   using DecisionTree::DecisionTree;
 
-  auto evaluate() -> std::unique_ptr<Event> override {
-    if (_state.enemy != utils::sentinelBox) {
+  auto enter() -> bool override {
+    if (_state.enemy() != utils::sentinelBox) {
       _iterationsWaited = iterationDelay;
     }
     if (_iterationsWaited == 0) {
-      return DecisionTree::evaluate();
+      return true;
     }
     --_iterationsWaited;
-    return std::make_unique<EmptyEvent>();
+    return false;
   }
 
 private:
@@ -110,75 +151,89 @@ private:
 
 class ImageCapturingTree : public DecisionTree {
 public:
-  ImageCapturingTree(GameState& gameState, Synchronizer& synchronizer) :
-      DecisionTree {gameState}, _synchronizer {synchronizer} {
-    _image = new unsigned char[expectedScreenHeight * expectedScreenWidth * 3];
-  }
-
-  ~ImageCapturingTree() override { delete[] _image; }
+  using DecisionTree::DecisionTree;
 
-  auto act() -> std::unique_ptr<Event> override { return std::make_unique<ScreenshotEvent>(_image); }
-  auto postEvaluation() -> void override {
-    _synchronizer.requestSynchronization();
-    _state.set(GameState::Properties::IMAGE, Image {_image});
+  //a capture still in flight is left to finish instead of queueing another one behind it
+  auto act() -> AnyEvent override {
+    if (!_state.frames.beginCapture()) {
+      return EmptyEvent {};
+    }
+    //a capture starts a flow of its own rather than continuing the one of the previous frame
+    utils::trace::setFlow(0);
+    return ScreenshotEvent {_state.frames};
   }
-
-private:
-  Synchronizer& _synchronizer;
-  unsigned char* _image {};
 };
 
-class EnemyDetectionTree : public DecisionTree {
+//the detector is anything constructed from a script path with an analyzeImage returning the boxes found in a frame
+template <typename Detector = utils::ObjectDetectionController> class EnemyDetectionTree : public DecisionTree {
 public:
   EnemyDetectionTree(GameState& gameState, std::string const& scriptPath) :
-      DecisionTree {gameState}, _objectDetectionController {scriptPath} {}
-
-  auto evaluate() -> std::unique_ptr<Event> override {
-    auto* image = _state.image().data;
-    if (auto enemyList = _objectDetectionController.analyzeImage(image); !enemyList.empty()) {
+      DecisionTree {gameState}, _detector {scriptPath} {}
+
+  //runs on the newest captured frame while the next one is being captured; a frame is only analyzed, and the subtree
+  //only acts on it, once. Ticks before a new frame is published skip the subtree
+  auto enter() -> bool override {
+    auto const frame = _state.frames.latest();
+    if (frame.sequence == _analyzedSequence) {
+      return false;
+    }
+    _analyzedSequence = frame.sequence;
+    utils::trace::setFlow(frame.sequence);
+    if (auto enemyList = _detector.analyzeImage(frame.data); !enemyList.empty()) {
       auto pointChooser = [](utils::BoundingBox const& b1, utils::BoundingBox const& b2) {
         return ((b1.topLeft + b1.bottomRight - screenPoint) / 2).abs()
             < ((b2.topLeft + b2.bottomRight - screenPoint) / 2).abs();
       };
-      _state.enemy = *std::ranges::min_element(enemyList, pointChooser);
+      _state.set(GameState::Properties::ENEMY, *std::ranges::min_element(enemyList, pointChooser));
     } else {
-      _state.enemy = utils::sentinelBox;
+      _state.set(GameState::Properties::ENEMY, utils::sentinelBox);
     }
-    return DecisionTree::evaluate();
+    utils::trace::publishFlow(frame.sequence);
+    return true;
+  }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {0, GameState::Field::ENEMY};
   }
 
 private:
-  utils::ObjectDetectionController _objectDetectionController;
+  Detector _detector;
+  uint64 _analyzedSequence {};
 };
 
 class ShootingTree : public DecisionTree {
 public:
   using DecisionTree::DecisionTree;
 
-  auto act() -> std::unique_ptr<Event> override {
-    if (_state.enemy == utils::sentinelBox
-        || _state.inventory().currentWeaponState() == Inventory::ActiveWeaponState::RELOADING) {
-      return std::make_unique<EmptyEvent>();
+  auto act() -> AnyEvent override {
+    auto const state = _state.snapshot();
+    if (state.enemy == utils::sentinelBox
+        || state.inventory.currentWeaponState() == Inventory::ActiveWeaponState::RELOADING) {
+      return EmptyEvent {};
     }
     return shoot();
   }
 
-  virtual auto shoot() -> std::unique_ptr<Event> = 0;
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::ENEMY | GameState::Field::INVENTORY, 0};
+  }
+
+  virtual auto shoot() -> AnyEvent = 0;
 };
 
 class SlowShootingTree : public ShootingTree {
 public:
   using ShootingTree::ShootingTree;
 
-  auto shoot() -> std::unique_ptr<Event> override {
+  auto shoot() -> AnyEvent override {
     auto timeNow = std::chrono::system_clock::now();
 
     if (std::chrono::duration_cast<std::chrono::microseconds>(timeNow - lastShootTime).count() < shootWaitTime) {
-      return std::make_unique<EmptyEvent>();
+      return EmptyEvent {};
     }
 
-    auto shootingPoint =
-        (_state.enemy.topLeft + (_state.enemy.bottomRight - _state.enemy.topLeft) / Point {2, 5} - screenPoint / 2) * 2;
+    auto enemy = _state.enemy();
+    auto shootingPoint = (enemy.topLeft + (enemy.bottomRight - enemy.topLeft) / Point {2, 5} - screenPoint / 2) * 2;
     ShootEvent::AimType aimType;
     if (std::abs(shootingPoint.x) > 50 || std::abs(shootingPoint.y) > 50) {
       aimType = ShootEvent::AimType::FLICK;
@@ -186,7 +241,7 @@ public:
       aimType = ShootEvent::AimType::TAP;
     }
     lastShootTime = timeNow;
-    return std::make_unique<ShootEvent>(shootingPoint, aimType);
+    return ShootEvent {shootingPoint, aimType};
   }
 
 private:
@@ -198,16 +253,18 @@ class SprayShootingTree : public ShootingTree {
 public:
   using ShootingTree::ShootingTree;
 
-  auto shoot() -> std::unique_ptr<Event> override {
-    auto shootingPoint = (_state.enemy.topLeft + _state.enemy.bottomRight) - screenPoint;
+  auto shoot() -> AnyEvent override {
+    auto const state = _state.snapshot();
+    auto enemy = state.enemy;
+    auto shootingPoint = (enemy.topLeft + enemy.bottomRight) - screenPoint;
     int bulletCount {};
-    if (_state.inventory().currentWeaponClass() == Inventory::WeaponClass::WC_PRIMARY) {
+    if (state.inventory.currentWeaponClass() == Inventory::WeaponClass::WC_PRIMARY) {
       bulletCount = 6;
     } else {
       bulletCount = 4;
     }
-    bulletCount = std::min(bulletCount, _state.inventory().currentWeapon().ammo);
-    return std::make_unique<SprayEvent>(shootingPoint, bulletCount, _state.inventory().currentWeapon().weapon);
+    bulletCount = std::min(bulletCount, state.inventory.currentWeapon().ammo);
+    return SprayEvent {shootingPoint, bulletCount, state.inventory.currentWeapon().weapon};
   }
 };
 
@@ -216,9 +273,13 @@ public:
   PositionGettingTree(GameState& gameState, Synchronizer& synchronizer) :
       DecisionTree {gameState}, _synchronizer {synchronizer} {}
 
-  auto act() -> std::unique_ptr<Event> override { return std::make_unique<KeyPressEvent>('p', 100); }
+  auto act() -> AnyEvent override { return KeyPressEvent {'p', 100}; }
   auto postEvaluation() -> void override { _synchronizer.requestSynchronization(); }
 
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {0, GameState::Field::POSITION | GameState::Field::ORIENTATION};
+  }
+
 private:
   Synchronizer& _synchronizer;
 };
@@ -227,13 +288,17 @@ class DestinationChoosingTree : public EnemyDependentTree<10> {
 public:
   using EnemyDependentTree::EnemyDependentTree;
 
-  auto evaluate() -> std::unique_ptr<Event> override {
+  auto enter() -> bool override {
     if (_state.round().bombState() == Round::BombState::PLANTED) {
-      _state.targetZone.name = Map::ZoneName::GOOSE;
+      _state.targetZone = Map::ZoneName::GOOSE;
     } else {
-      _state.targetZone.name = Map::ZoneName::A_SITE;
+      _state.targetZone = Map::ZoneName::A_SITE;
     }
-    return EnemyDependentTree::evaluate();
+    return EnemyDependentTree::enter();
+  }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::ROUND, GameState::Field::TARGET_ZONE};
   }
 };
 
@@ -241,10 +306,14 @@ template <typename PathChoosingPolicy> class PathChoosingTree : public DecisionT
 public:
   using DecisionTree::DecisionTree;
 
-  auto evaluate() -> std::unique_ptr<Event> override {
-    _policy.getPath(_state.map.findZone(_state.position()).name, _state.targetZone.name);
+  auto enter() -> bool override {
+    _policy.getPath(_state.position(), _state.targetZone);
     _state.currentPath = _policy.path;
-    return DecisionTree::evaluate();
+    return true;
+  }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::POSITION | GameState::Field::TARGET_ZONE, GameState::Field::CURRENT_PATH};
   }
 
 private:
@@ -255,28 +324,37 @@ template <typename MovementPolicy> class LocationChoosingTree : public DecisionT
 public:
   using DecisionTree::DecisionTree;
 
-  auto act() -> std::unique_ptr<Event> override {
-    auto position = _state.position();
-    auto currentZone = _state.map.findZone(position);
+  auto act() -> AnyEvent override {
+    auto const state = _state.snapshot();
+    auto position = state.position;
+    auto const currentZone = _state.map.findZoneId(position);
     auto nextZone = _state.currentPath.back();
     Position nextPoint = position;
-    if (currentZone.zone == nextZone) {
-      if (_state.round().bombState() == Round::BombState::PLANTED) {
-        nextPoint = currentZone.zone.hidingSpots[0].center();
+    if (currentZone == nextZone) {
+      if (state.round.bombState() == Round::BombState::PLANTED) {
+        nextPoint = _state.map.zone(currentZone).zone.hidingSpots[0].center();
       }
     } else {
-      nextPoint = MovementPolicy {_state.map}.getNextPoints(position, currentZone.zone, _state.currentPath).back();
+      nextPoint = _policy.getNextPoint(position, currentZone, _state.currentPath);
     }
     _state.nextPosition = nextPoint;
-    return std::make_unique<EmptyEvent>();
+    return EmptyEvent {};
+  }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::POSITION | GameState::Field::CURRENT_PATH | GameState::Field::ROUND,
+            GameState::Field::NEXT_POSITION};
   }
+
+private:
+  MovementPolicy _policy {_state.map};
 };
 
 class RotationTree : public DecisionTree {
 public:
   using DecisionTree::DecisionTree;
 
-  auto act() -> std::unique_ptr<Event> override {
+  auto act() -> AnyEvent override {
     auto orientation = _state.orientation();
     auto moveAngle = orientation.y - _targetAngle;
     if (std::abs(moveAngle) > 180.0f) {
@@ -286,9 +364,12 @@ public:
     orientation.y = _targetAngle;
     orientation.x = 0;
     _state.set(GameState::Properties::ORIENTATION, orientation);
-    return std::make_unique<RotationEvent>(moveAngle, -oldXOrientation);
+    return RotationEvent {moveAngle, -oldXOrientation};
   }
 
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::ORIENTATION, GameState::Field::ORIENTATION};
+  }
 
 protected:
   float _targetAngle {};
@@ -298,40 +379,41 @@ class MovementOrientedRotationTree : public RotationTree {
 public:
   using RotationTree::RotationTree;
 
-  auto act() -> std::unique_ptr<Event> override {
+  auto act() -> AnyEvent override {
     auto position = _state.position();
     auto targetPosition = _state.nextPosition;
     _targetAngle = Vector(position, targetPosition).getAngle();
     return RotationTree::act();
   }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return RotationTree::ownAccess() | ResourceAccess {GameState::Field::POSITION | GameState::Field::NEXT_POSITION, 0};
+  }
 };
 
 class AimingOrientedRotationTree : public MovementOrientedRotationTree {
 public:
   using MovementOrientedRotationTree::MovementOrientedRotationTree;
 
-  auto act() -> std::unique_ptr<Event> override {
+  auto act() -> AnyEvent override {
     auto position = _state.position();
-    auto possibleWatchpoints = _state.map.watchpoints(_state.map.findZone(position).zone);
-    if (possibleWatchpoints.empty()) {
+    auto const zone = _state.map.findZoneId(position);
+    auto const cell = _state.map.navigationGrid(zone).closestCell(position);
+    auto const watchpoint = _state.map.sampleWatchpoint(zone, cell, _generator);
+    if (!watchpoint) {
       return MovementOrientedRotationTree::act();
     }
 
-    std::mt19937 gen(_rd());
-    std::ranges::shuffle(possibleWatchpoints, gen);
-    _targetAngle = Vector(position, possibleWatchpoints.back()).getAngle();
+    _targetAngle = Vector(position, *watchpoint).getAngle();
     return RotationTree::act();
   }
-
-private:
-  std::random_device _rd {};
 };
 
 class BackCheckingRotationTree : public RotationTree {
 public:
   using RotationTree::RotationTree;
 
-  auto act() -> std::unique_ptr<Event> override {
+  auto act() -> AnyEvent override {
     auto orientation = _state.orientation().y;
     _targetAngle = orientation < 0.0f ? (orientation + 180.0f) : (orientation - 180.0f);
     return RotationTree::act();
@@ -342,26 +424,17 @@ class AimingTree : public EnemyDependentTree<10> {
 public:
   using EnemyDependentTree::EnemyDependentTree;
 
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override { return {GameState::Field::ROUND, 0}; }
+
   auto postEvaluation() -> void override {
-    if (_state.round().bombState() == Round::BombState::PLANTED) {
-      for (auto& child : _children) {
-        if (dynamic_cast<AimingOrientedRotationTree*>(child.decision.get()) != nullptr) {
-          child.weight = 1.0f;
-        } else {
-          child.weight = 0.0f;
-        }
-      }
-    } else {
-      for (auto& child : _children) {
-        if (dynamic_cast<AimingOrientedRotationTree*>(child.decision.get()) != nullptr) {
-          child.weight = 0.4f;
-        } else {
-          if (dynamic_cast<MovementOrientedRotationTree*>(child.decision.get()) != nullptr) {
-            child.weight = 0.55f;
-          } else {
-            child.weight = 0.05f;
-          }
-        }
+    auto const planted = _state.round().bombState() == Round::BombState::PLANTED;
+    for (auto& child : _children) {
+      if (dynamic_cast<AimingOrientedRotationTree*>(child.decision.get()) != nullptr) {
+        setWeight(child, planted ? 1.0f : 0.4f);
+      } else if (dynamic_cast<MovementOrientedRotationTree*>(child.decision.get()) != nullptr) {
+        setWeight(child, planted ? 0.0f : 0.55f);
+      } else {
+        setWeight(child, planted ? 0.0f : 0.05f);
       }
     }
     DecisionTree::postEvaluation();
@@ -372,22 +445,23 @@ class MovementTree : public EnemyDependentTree<10> {
 public:
   using EnemyDependentTree::EnemyDependentTree;
 
-  auto act() -> std::unique_ptr<Event> override {
-    auto position = _state.position();
-    auto currentZone = _state.map.findZone(position);
+  auto act() -> AnyEvent override {
+    auto const state = _state.snapshot();
+    auto position = state.position;
+    auto const currentZone = _state.map.findZoneId(position);
+    auto const& currentVolume = _state.map.zone(currentZone).zone.volume;
     auto nextZone = _state.currentPath.back();
-    auto movementVector = Vector {position, _state.nextPosition}.multiply(-_state.orientation().y);
-    for (auto possibleTransitions = _state.map.possibleTransitions(currentZone.zone, nextZone);
-         auto const& transition : possibleTransitions) {
+    auto movementVector = Vector {position, _state.nextPosition}.multiply(-state.orientation.y);
+    for (auto const& transition : _state.map.possibleTransitions(currentZone, nextZone)) {
       if (transition.transitionArea.contains(position)
-          || transition.transitionArea.commonRegion(currentZone.zone.volume).contains(position)) {
+          || transition.transitionArea.commonRegion(currentVolume).contains(position)) {
         switch (transition.movement) {
           using enum Map::RequiredMovement;
           case JUMP: {
-            return std::make_unique<JumpEvent>(movementVector, false);
+            return JumpEvent {movementVector, false};
           }
           case JUMP_AND_CROUCH: {
-            return std::make_unique<JumpEvent>(movementVector, true);
+            return JumpEvent {movementVector, true};
           }
           default: {
             break;
@@ -395,7 +469,13 @@ public:
         }
       }
     }
-    return std::make_unique<MovementEvent>(movementVector, 6000 * 30);
+    return MovementEvent {movementVector, 6000 * 30};
+  }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::POSITION | GameState::Field::ORIENTATION | GameState::Field::CURRENT_PATH
+                | GameState::Field::NEXT_POSITION,
+            0};
   }
 };
 
@@ -403,48 +483,55 @@ class WeaponChoosingTree : public DecisionTree {
 public:
   using DecisionTree::DecisionTree;
 
-  auto act() -> std::unique_ptr<Event> override {
+  auto act() -> AnyEvent override {
+    auto const state = _state.snapshot();
     char keyToPress {};
 
-    if (_state.inventory().currentWeaponState() == Inventory::ActiveWeaponState::RELOADING) {
-      return std::make_unique<EmptyEvent>();
+    if (state.inventory.currentWeaponState() == Inventory::ActiveWeaponState::RELOADING) {
+      return EmptyEvent {};
     }
 
-    if (_state.enemy != utils::sentinelBox) {
+    if (state.enemy != utils::sentinelBox) {
       _iterationsHeld = persistanceCount;
-      if (_state.inventory().weapons()[0].weapon != NO_WEAPON
-          && (_state.inventory().weapons()[0].ammo >= 5 || _state.inventory().weapons()[1].ammo < 5)) {
+      if (state.inventory.weapons()[0].weapon != NO_WEAPON
+          && (state.inventory.weapons()[0].ammo >= 5 || state.inventory.weapons()[1].ammo < 5)) {
         keyToPress = '1';
       } else {
         keyToPress = '2';
       }
     } else {
-      if (_state.inventory().weapons()[0].weapon != NO_WEAPON) {
-        if (_state.inventory().weapons()[0].ammo == 0) {
-          return std::make_unique<KeyPressEvent>('1', 500);
+      if (state.inventory.weapons()[0].weapon != NO_WEAPON) {
+        if (state.inventory.weapons()[0].ammo == 0) {
+          return KeyPressEvent {'1', 500};
         }
       } else {
-        if (_state.inventory().weapons()[1].ammo == 0) {
-          return std::make_unique<KeyPressEvent>('2', 500);
+        if (state.inventory.weapons()[1].ammo == 0) {
+          return KeyPressEvent {'2', 500};
         }
       }
 
       if (_iterationsHeld != 0) {
         --_iterationsHeld;
-        return std::make_unique<EmptyEvent>();
+        return EmptyEvent {};
       }
-      if (_state.inventory().currentWeaponState() == Inventory::ActiveWeaponState::RELOADING
-          || _state.inventory().currentWeapon().weapon == BOMB) {
-        return std::make_unique<EmptyEvent>();
+      if (state.inventory.currentWeaponState() == Inventory::ActiveWeaponState::RELOADING
+          || state.inventory.currentWeapon().weapon == BOMB) {
+        return EmptyEvent {};
       }
-      if (_state.map.findZone(_state.position()).name == Map::ZoneName::A_SITE
-          && _state.round().bombState() != Round::BombState::PLANTED) {
+      if (_state.map.findZone(state.position).name == Map::ZoneName::A_SITE
+          && state.round.bombState() != Round::BombState::PLANTED) {
         keyToPress = '5';
       } else {
         keyToPress = '3';
       }
     }
-    return std::make_unique<KeyPressEvent>(keyToPress, 500);
+    return KeyPressEvent {keyToPress, 500};
+  }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::INVENTORY | GameState::Field::ENEMY | GameState::Field::POSITION
+                | GameState::Field::ROUND,
+            0};
   }
 
 private:
@@ -456,12 +543,12 @@ class SituationalTree : public DecisionTree {
 public:
   using DecisionTree::DecisionTree;
 
-  auto evaluate() -> std::unique_ptr<Event> override {
+  auto enter() -> bool override {
     if (conditionsFulfilled()) {
-      return DecisionTree::evaluate();
+      return true;
     }
     checkConditionInfluencers();
-    return std::make_unique<EmptyEvent>();
+    return false;
   }
   [[nodiscard]] virtual auto conditionsFulfilled() const -> bool = 0;
   virtual auto checkConditionInfluencers() -> void {
@@ -474,12 +561,17 @@ public:
   using SituationalTree::SituationalTree;
 
   [[nodiscard]] auto conditionsFulfilled() const -> bool override {
-    return _state.map.findZone(_state.position()).name == Map::ZoneName::A_SITE
-        && _state.round().bombState() != Round::BombState::PLANTED && _state.inventory().currentWeapon().weapon == BOMB;
+    auto const state = _state.snapshot();
+    return _state.map.findZone(state.position).name == Map::ZoneName::A_SITE
+        && state.round.bombState() != Round::BombState::PLANTED && state.inventory.currentWeapon().weapon == BOMB;
   }
 
-  auto act() -> std::unique_ptr<Event> override {
-    return std::make_unique<MouseHoldEvent>(MouseButton::Button::LEFT_BUTTON, 6);
+  auto act() -> AnyEvent override {
+    return MouseHoldEvent {MouseButton::Button::LEFT_BUTTON, 6};
+  }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::POSITION | GameState::Field::ROUND | GameState::Field::INVENTORY, 0};
   }
 };
 
@@ -497,26 +589,31 @@ public:
     }
   }
 
-  auto act() -> std::unique_ptr<Event> override {
-    std::vector<BuyEvent::Item> itemsToBuy;
-    if (_state.player().armor() == 0) {
-      if (!_state.player().hasHelmet()) {
-        itemsToBuy.push_back(BuyEvent::Item::KEVLAR_HELMET);
+  auto act() -> AnyEvent override {
+    auto const state = _state.snapshot();
+    BuyEvent buyEvent {};
+    if (state.player.armor() == 0) {
+      if (!state.player.hasHelmet()) {
+        buyEvent.add(BuyEvent::Item::KEVLAR_HELMET);
       } else {
-        itemsToBuy.push_back(BuyEvent::Item::KEVLAR);
+        buyEvent.add(BuyEvent::Item::KEVLAR);
       }
     } else {
-      if (_state.player().money() > 4000 || _state.player().armor() < 30) {
-        itemsToBuy.push_back(BuyEvent::Item::KEVLAR);
+      if (state.player.money() > 4000 || state.player.armor() < 30) {
+        buyEvent.add(BuyEvent::Item::KEVLAR);
       }
     }
-    if (_state.inventory().weapons()[0].weapon == NO_WEAPON && _state.player().money() > 2700) {
-      itemsToBuy.push_back(BuyEvent::Item::AK_47);
+    if (state.inventory.weapons()[0].weapon == NO_WEAPON && state.player.money() > 2700) {
+      buyEvent.add(BuyEvent::Item::AK_47);
     }
 
     _buyingNeeded = false;
 
-    return std::make_unique<BuyEvent>(itemsToBuy);
+    return buyEvent;
+  }
+
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override {
+    return {GameState::Field::ROUND | GameState::Field::PLAYER | GameState::Field::INVENTORY, 0};
   }
 
 private:
@@ -6,100 +6,286 @@
 #include "DecisionTree.hpp"
 #include "GameState.hpp"
 #include "Path.hpp"
+#include "StaticDecisionTree.hpp"
 #include "gameStateIntegrator/Integrator.hpp"
+#include "multithreaded/scheduler/Scheduler.hpp"
 #include "positionReader/PositionReader.hpp"
+#include "replay/EventLog.hpp"
+#include "replay/Recorder.hpp"
+#include "replay/Replayer.hpp"
+#include "utils/random/Random.hpp"
+#include "utils/trace/Trace.hpp"
 #include "windowController/WindowController.hpp"
+#include <csignal>
+#include <cstdlib>
 
 namespace gabe {
+using namespace std::chrono_literals;
+
 class Engine {
 public:
   Engine() = delete;
   Engine(Engine const&) = delete;
   Engine(Engine&&) noexcept = delete;
 
+  //plays the game; GABE_RECORD names a file every input taken from the game is recorded to and GABE_INPUT=uinput
+  //injects input through a virtual device instead of XTest
   explicit Engine(std::string const& rootFolder, std::string const& csgoRootPath) :
-      _windowController {rootFolder + "scripts/find_csXwindow.sh", _synchronizer},
-      _positionReader {_state, csgoRootPath + "game/csgo"}, _integrator {_state} {
-    buildTrees(rootFolder);
+      _state {mapFile},
+      _windowController {std::make_unique<WindowController>(rootFolder + "scripts/find_csXwindow.sh", _synchronizer,
+                                                             inputFromEnvironment())},
+      _positionReader {std::make_unique<PositionReader>(_state, csgoRootPath + "game/csgo")},
+      _integrator {std::make_unique<Integrator>(_state)}, _pSink {_windowController.get()} {
+    if (auto const* path = std::getenv("GABE_RECORD"); path != nullptr) {
+      replay::startRecording(path);
+      log(std::string {"Recording inputs to "} + path, OpState::INFO);
+    }
+    setup(rootFolder);
+  }
+
+  //runs headless on a recording, without the game or a display; events go to the event log at eventLogPath, if given
+  Engine(std::string const& rootFolder, replay::Recording&& recording, replay::Pace pace,
+         std::string const& eventLogPath = "", uint64 seed = 0) :
+      _state {mapFile}, _replayer {std::make_unique<replay::Replayer>(_state, std::move(recording), pace)},
+      _eventLog {eventLogPath.empty() ? std::make_unique<replay::EventLog>()
+                                      : std::make_unique<replay::EventLog>(eventLogPath)},
+      _pSink {_eventLog.get()} {
+    utils::random::seedStreams(seed);
+    setup(rootFolder);
   }
 
   ~Engine() {
-    _windowController.stop();
-    _positionReader.stop();
-    _integrator.stop();
+    _scheduler.report();
+    if (utils::trace::enabled()) {
+      dumpTrace();
+    }
+    if (live()) {
+      _windowController->stop();
+      _positionReader->stop();
+      _integrator->stop();
+      //destructors must not throw; a recording which could not be written is reported instead
+      try {
+        replay::flushRecording();
+      } catch (replay::exceptions::RecordingWriteException const& e) {
+        log("Error: " + std::string {e.what()}, OpState::FAILURE);
+      }
+    } else {
+      _replayer->stop();
+    }
     log("Stopped processing commands", OpState::SUCCESS);
   }
 
   auto run() -> int {
     log("Started processing commands", OpState::SUCCESS);
-    _windowController.run();
-    _positionReader.run();
-    _integrator.run();
+    if (!live()) {
+      return runReplay();
+    }
+    _windowController->run();
+    _positionReader->run();
+    _integrator->run();
 
     setupCommands();
 
     while (true) {
-      if (_state.round().stage() == Round::Stage::OVER) {
-        continue;
+      if (_scheduler.runOnce() != 0) {
+        _synchronizer.requestSynchronization();
       }
-      for (auto const& e : _trees) {
-        _windowController.addEvent(e->evaluate());
-        e->postEvaluation();
+      if (utils::trace::dumpRequested()) {
+        dumpTrace();
       }
-      _synchronizer.requestSynchronization();
-      usleep(6000);
     }
     return 0;
   }
 
+  //events produced by the trees; only kept for headless engines
+  [[nodiscard]] auto eventLog() const -> replay::EventLog const* { return _eventLog.get(); }
+
 private:
+  static constexpr Size schedulerWorkerCount = 4;
+  //compiled by the build into GABE_MAPS_FOLDER
+  static constexpr auto mapFile = GABE_MAPS_FOLDER "de_dust2.nav";
+  static constexpr Scheduler::Timing frameTiming {16ms, 16ms};
+  static constexpr Scheduler::Timing controlTiming {33ms, 33ms};
+  static constexpr Scheduler::Timing planningTiming {250ms, 100ms};
+  static constexpr Scheduler::Timing situationalTiming {100ms, 100ms};
+  static constexpr Scheduler::Timing roundTiming {1000ms, 100ms, true};
+
+  //GABE_INCREMENTAL_MOVEMENT repairs a search of the current zone between ticks instead of reading baked flow fields
+#ifdef GABE_INCREMENTAL_MOVEMENT
+  using ZoneMovementPolicy = IncrementalMovementPolicy;
+#else
+  using ZoneMovementPolicy = FlowFieldMovementPolicy;
+#endif
+
+  auto schedule(std::string const& name, Scheduler::Timing const& timing, std::unique_ptr<DecisionTree>&& tree)
+      -> void {
+    auto access = tree->access();
+    _scheduler.addTask(
+        name, timing,
+        [this, pTree = tree.get(), traceName = utils::trace::intern(name)] {
+          utils::trace::setFlow(utils::trace::latestFlow());
+          {
+            utils::trace::Span span {traceName, utils::trace::Stage::EVALUATION};
+            auto event = pTree->evaluate();
+            span.setFlow(utils::trace::currentFlow());
+            _pSink->addEvent(std::move(event), utils::trace::takeFlow());
+          }
+          pTree->postEvaluation();
+        },
+        access);
+    _trees.push_back(std::move(tree));
+  }
+
+  static auto inputFromEnvironment() -> WindowController::Input {
+    auto const* input = std::getenv("GABE_INPUT");
+    return input != nullptr && std::string_view {input} == "uinput" ? WindowController::Input::UINPUT
+                                                                    : WindowController::Input::XTEST;
+  }
+
+  auto setup(std::string const& rootFolder) -> void {
+    buildTrees(rootFolder);
+    _scheduler.setGate([this] { return _state.round().stage() != Round::Stage::OVER; });
+    _state.setUpdateListener([this] { _scheduler.notify(); });
+    setupTracing();
+  }
+
+  //image capturing and position getting drive the game; a headless engine gets both from its recording instead
+  [[nodiscard]] auto live() const -> bool { return _windowController != nullptr; }
+
+  auto runReplay() -> int {
+    if (_replayer->pace() == replay::Pace::FAST) {
+      _eventLog->setElapsed([this] { return _scheduler.steppedTime().time_since_epoch(); });
+      _replayer->replayStepped(_scheduler);
+    } else {
+      _replayer->run();
+      while (!_replayer->finished()) {
+        _scheduler.runOnce();
+        if (utils::trace::dumpRequested()) {
+          dumpTrace();
+        }
+      }
+    }
+    log("Replayed " + std::to_string(_replayer->appliedCount()) + " recorded inputs, producing "
+            + std::to_string(_eventLog->total()) + " events",
+        OpState::SUCCESS);
+    return 0;
+  }
+
+  //tracing is enabled by pointing GABE_TRACE at the file the Chrome trace is written to; SIGUSR1 dumps it on demand
+  auto setupTracing() -> void {
+    if (auto const* path = std::getenv("GABE_TRACE"); path != nullptr) {
+      _tracePath = path;
+      utils::trace::enable();
+      std::signal(SIGUSR1, [](int) { utils::trace::requestDump(); });
+      log("Tracing to " + _tracePath + ", send SIGUSR1 to dump", OpState::INFO);
+    }
+  }
+
+  auto dumpTrace() const -> void {
+    utils::trace::Report const report {};
+    log("Latencies:\n" + report.summary(), OpState::INFO);
+    if (!report.writeChromeTrace(_tracePath)) {
+      log("Could not write trace to " + _tracePath, OpState::FAILURE);
+    }
+  }
+
+#ifdef GABE_RUNTIME_DECISION_TREES
   auto buildTrees(std::string const& rootFolder) -> void {
-    buildImageCapturingTree();
+    if (live()) {
+      buildImageCapturingTree();
+    }
     buildShootingTree(rootFolder + "scripts/objectDetection");
-    buildPositionGettingTree();
+    if (live()) {
+      buildPositionGettingTree();
+    }
     buildTargetChoosingTree();
     buildAimingTree();
     buildMovementTree();
     buildWeaponsChoosingTree();
     buildSituationalTrees();
   }
+#else
+  struct AimingWeights {
+    static constexpr std::array regular {0.55f, 0.4f, 0.05f};
+    static constexpr std::array planted {0.0f, 1.0f, 0.0f};
+  };
+
+  //same trees as the runtime builders below, with their shape fixed at compile time
+  auto buildTrees(std::string const& rootFolder) -> void {
+    auto const objectDetectionPath = rootFolder + "scripts/objectDetection";
+    if (live()) {
+      schedule("image capturing", frameTiming,
+               makeStaticTree(_state, [this] { return staticLeaf<ImageCapturingTree>(_state); }));
+    }
+    schedule("shooting", frameTiming, makeStaticTree(_state, [this, &objectDetectionPath] {
+               return staticNode<EnemyDetectionTree<>>(std::forward_as_tuple(_state, objectDetectionPath), {0.8f, 0.2f},
+                                                     staticLeaf<SlowShootingTree>(_state),
+                                                     staticLeaf<SprayShootingTree>(_state));
+             }));
+    if (live()) {
+      schedule("position getting", controlTiming, makeStaticTree(_state, [this] {
+                 return staticLeaf<PositionGettingTree>(_state, _positionReader->synchronizer);
+               }));
+    }
+    schedule("target choosing", planningTiming, makeStaticTree(_state, [this] {
+               return staticNode<DestinationChoosingTree>(
+                   std::forward_as_tuple(_state), {1.0f},
+                   staticNode<PathChoosingTree<HierarchicalPathPolicy>>(
+                       std::forward_as_tuple(_state), {1.0f},
+                       staticLeaf<LocationChoosingTree<ZoneMovementPolicy>>(_state)));
+             }));
+    schedule("aiming", controlTiming, makeStaticTree(_state, [this] {
+               return staticNode<AimingTree, BombStateWeights<AimingWeights>>(
+                   std::forward_as_tuple(_state), AimingWeights::regular,
+                   staticLeaf<MovementOrientedRotationTree>(_state), staticLeaf<AimingOrientedRotationTree>(_state),
+                   staticLeaf<BackCheckingRotationTree>(_state));
+             }));
+    schedule("movement", controlTiming, makeStaticTree(_state, [this] { return staticLeaf<MovementTree>(_state); }));
+    schedule("weapon choosing", situationalTiming,
+             makeStaticTree(_state, [this] { return staticLeaf<WeaponChoosingTree>(_state); }));
+    schedule("bomb planting", situationalTiming,
+             makeStaticTree(_state, [this] { return staticLeaf<BombPlantingTree>(_state); }));
+    schedule("buying", roundTiming, makeStaticTree(_state, [this] { return staticLeaf<BuyingTree>(_state); }));
+  }
+#endif
 
 #ifndef NDEBUG
   auto setupCommands() -> void {
-    _windowController.addEvent(std::make_unique<CommandEvent>("sv_cheats true"));
-    _windowController.addEvent(std::make_unique<CommandEvent>("bind p getpos"));
-    _windowController.addEvent(std::make_unique<CommandEvent>("mp_autoteambalance false"));
-    _windowController.addEvent(std::make_unique<CommandEvent>("mp_roundtime 600"));
-    _windowController.addEvent(std::make_unique<CommandEvent>("mp_roundtime_defuse 600"));
-    _windowController.addEvent(std::make_unique<CommandEvent>("mp_limitteams 5"));
-    _windowController.addEvent(std::make_unique<CommandEvent>("sv_infinite_ammo 2"));
-    //_windowController.addEvent(std::make_unique<CommandEvent>("bot_kick"));
-    //_windowController.addEvent(std::make_unique<CommandEvent>("bot_add ct"));
-    _windowController.addEvent(std::make_unique<CommandEvent>("bot_stop 0"));
+    _windowController->addEvent(CommandEvent {"sv_cheats true"});
+    _windowController->addEvent(CommandEvent {"bind p getpos"});
+    _windowController->addEvent(CommandEvent {"mp_autoteambalance false"});
+    _windowController->addEvent(CommandEvent {"mp_roundtime 600"});
+    _windowController->addEvent(CommandEvent {"mp_roundtime_defuse 600"});
+    _windowController->addEvent(CommandEvent {"mp_limitteams 5"});
+    _windowController->addEvent(CommandEvent {"sv_infinite_ammo 2"});
+    //_windowController->addEvent(CommandEvent {"bot_kick"});
+    //_windowController->addEvent(CommandEvent {"bot_add ct"});
+    _windowController->addEvent(CommandEvent {"bot_stop 0"});
   }
 
 #else
   auto setupCommands() -> void {
-    _windowController.addEvent(std::make_unique<CommandEvent>("sv_cheats true"));
-    _windowController.addEvent(std::make_unique<CommandEvent>("bind p getpos"));
+    _windowController->addEvent(CommandEvent {"sv_cheats true"});
+    _windowController->addEvent(CommandEvent {"bind p getpos"});
   }
 #endif
 
   auto buildImageCapturingTree() -> void {
-    _trees.push_back(std::make_unique<ImageCapturingTree>(_state, _synchronizer));
+    schedule("image capturing", frameTiming, std::make_unique<ImageCapturingTree>(_state));
   }
 
   auto buildShootingTree(std::string const& objectDetectionRootPath) -> void {
-    auto shootingTreeRoot = std::make_unique<EnemyDetectionTree>(_state, objectDetectionRootPath);
+    auto shootingTreeRoot = std::make_unique<EnemyDetectionTree<>>(_state, objectDetectionRootPath);
     shootingTreeRoot->addDecision(0.8f, std::make_unique<SlowShootingTree>(_state));
     shootingTreeRoot->addDecision(0.2f, std::make_unique<SprayShootingTree>(_state));
-    _trees.push_back(std::move(shootingTreeRoot));
+    schedule("shooting", frameTiming, std::move(shootingTreeRoot));
   }
 
-  auto buildMovementTree() -> void { _trees.push_back(std::make_unique<MovementTree>(_state)); }
+  auto buildMovementTree() -> void { schedule("movement", controlTiming, std::make_unique<MovementTree>(_state)); }
 
   auto buildPositionGettingTree() -> void {
-    _trees.push_back(std::make_unique<PositionGettingTree>(_state, _positionReader.synchronizer));
+    schedule("position getting", controlTiming,
+             std::make_unique<PositionGettingTree>(_state, _positionReader->synchronizer));
   }
 
   auto buildAimingTree() -> void {
@@ -107,29 +293,36 @@ private:
     aimingRootTree->addDecision(0.55f, std::make_unique<MovementOrientedRotationTree>(_state));
     aimingRootTree->addDecision(0.4f, std::make_unique<AimingOrientedRotationTree>(_state));
     aimingRootTree->addDecision(0.05f, std::make_unique<BackCheckingRotationTree>(_state));
-    _trees.push_back(std::move(aimingRootTree));
+    schedule("aiming", controlTiming, std::move(aimingRootTree));
   }
 
   auto buildTargetChoosingTree() -> void {
     auto destinationTree = std::make_unique<DestinationChoosingTree>(_state);
-    auto pathChoosingTree = std::make_unique<PathChoosingTree<ShortestPathPolicy>>(_state);
-    pathChoosingTree->addDecision(1.0f, std::make_unique<LocationChoosingTree<DirectMovementPolicy>>(_state));
+    auto pathChoosingTree = std::make_unique<PathChoosingTree<HierarchicalPathPolicy>>(_state);
+    pathChoosingTree->addDecision(1.0f, std::make_unique<LocationChoosingTree<ZoneMovementPolicy>>(_state));
     destinationTree->addDecision(1.0f, std::move(pathChoosingTree));
-    _trees.push_back(std::move(destinationTree));
+    schedule("target choosing", planningTiming, std::move(destinationTree));
   }
 
-  auto buildWeaponsChoosingTree() -> void { _trees.push_back(std::make_unique<WeaponChoosingTree>(_state)); }
+  auto buildWeaponsChoosingTree() -> void {
+    schedule("weapon choosing", situationalTiming, std::make_unique<WeaponChoosingTree>(_state));
+  }
 
   auto buildSituationalTrees() -> void {
-    _trees.push_back(std::make_unique<BombPlantingTree>(_state));
-    _trees.push_back(std::make_unique<BuyingTree>(_state));
+    schedule("bomb planting", situationalTiming, std::make_unique<BombPlantingTree>(_state));
+    schedule("buying", roundTiming, std::make_unique<BuyingTree>(_state));
   }
 
   Synchronizer _synchronizer {};
-  WindowController _windowController;
-  GameState _state {};
-  PositionReader _positionReader;
+  Scheduler _scheduler {schedulerWorkerCount};
+  GameState _state;
+  std::unique_ptr<WindowController> _windowController {};
+  std::unique_ptr<PositionReader> _positionReader {};
+  std::unique_ptr<Integrator> _integrator {};
+  std::unique_ptr<replay::Replayer> _replayer {};
+  std::unique_ptr<replay::EventLog> _eventLog {};
+  EventSink* _pSink;
   std::vector<std::unique_ptr<DecisionTree>> _trees {};
-  Integrator _integrator;
+  std::string _tracePath {};
 };
 } // namespace gabe
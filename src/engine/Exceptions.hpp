@@ -1,6 +1,10 @@
 //
 // Created by stefan on 4/26/24.
 //
+
+#pragma once
+
+#include "types.hpp"
 #include <exception>
 #include <string>
 #include <utility>
@@ -9,4 +13,26 @@ namespace gabe::exceptions {
 class DecisionAdditionException : public std::exception {
   [[nodiscard]] char const* what() const noexcept override { return "Weight of decision would go above the limit"; }
 };
+
+class InvalidNavFileException : public std::exception {
+public:
+  explicit InvalidNavFileException(std::string const& filePath) :
+      _msg {"File " + filePath + " is not a navigation file of this build"} {}
+
+  [[nodiscard]] char const* what() const noexcept override { return _msg.c_str(); }
+
+private:
+  std::string _msg;
+};
+
+class InvalidMapDescriptionException : public std::exception {
+public:
+  InvalidMapDescriptionException(Size line, std::string const& reason) :
+      _msg {"Map description line " + std::to_string(line) + ": " + reason} {}
+
+  [[nodiscard]] char const* what() const noexcept override { return _msg.c_str(); }
+
+private:
+  std::string _msg;
+};
 } // namespace gabe::exceptions
@@ -0,0 +1,99 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "BakedArray.hpp"
+#include "GridSearch.hpp"
+#include "NavFile.hpp"
+#include "NavigationGrid.hpp"
+#include "types.hpp"
+#include "utils/math/geometry/Geometry.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <span>
+#include <vector>
+
+namespace gabe {
+//For every cell of a zone's navigation grid, the point to head for next on a cheapest route to a set of goal areas
+//and the cost of that route, with the same moves and costs as GridSearch. Cells touching a goal area head for its
+//center. Every goal area has a distance which is added to the routes ending in it, so fields of consecutive zones
+//can be chained into distances to a common target
+class FlowField {
+public:
+  using Cell = NavigationGrid::Cell;
+
+  FlowField() = default;
+  FlowField(FlowField const&) = default;
+  FlowField(FlowField&&) noexcept = default;
+
+  //a backwards Dijkstra from the goal cells
+  FlowField(NavigationGrid const& grid, std::span<Volume const> goals, std::span<float const> goalDistances) {
+    std::vector<Position> waypoints(grid.size());
+    std::vector<float> distances(grid.size(), std::numeric_limits<float>::infinity());
+    using Entry = std::pair<float, Cell>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue {};
+    for (Cell cell = 0; cell < grid.size(); ++cell) {
+      waypoints[cell] = grid.center(cell);
+      auto const volume = grid.volume(cell);
+      for (Size goal = 0; goal < goals.size(); ++goal) {
+        if (goals[goal].intersects(volume) && goalDistances[goal] < distances[cell]) {
+          distances[cell] = goalDistances[goal];
+          waypoints[cell] = goals[goal].center();
+        }
+      }
+      if (distances[cell] != std::numeric_limits<float>::infinity()) {
+        queue.emplace(distances[cell], cell);
+      }
+    }
+
+    while (!queue.empty()) {
+      auto const [distance, cell] = queue.top();
+      queue.pop();
+      if (distance > distances[cell]) {
+        continue;
+      }
+      //moving from a neighbour onto this cell
+      auto const cost = distance + grid.penalty(cell);
+      grid.forEachStep(cell, [&](Cell next, float length) {
+        if (cost + length < distances[next]) {
+          distances[next] = cost + length;
+          waypoints[next] = grid.center(cell);
+          queue.emplace(cost + length, next);
+        }
+      });
+    }
+    _waypoints = BakedArray {std::move(waypoints)};
+    _distances = BakedArray {std::move(distances)};
+  }
+
+  auto operator=(FlowField const&) -> FlowField& = default;
+  auto operator=(FlowField&&) noexcept -> FlowField& = default;
+
+  [[nodiscard]] auto empty() const -> bool { return _waypoints.empty(); }
+  [[nodiscard]] auto size() const -> Size { return _waypoints.size(); }
+  [[nodiscard]] auto waypoint(Cell cell) const -> Position const& { return _waypoints[cell]; }
+  //in cells; infinite when no goal can be reached from the cell
+  [[nodiscard]] auto distance(Cell cell) const -> float { return _distances[cell]; }
+
+  auto write(nav::Writer& writer) const -> void {
+    writer.array(_waypoints);
+    writer.array(_distances);
+  }
+
+  static auto read(nav::Reader& reader) -> FlowField {
+    FlowField rez {};
+    rez._waypoints = reader.array<Position>();
+    rez._distances = reader.array<float>();
+    reader.expect(rez._waypoints.size() == rez._distances.size());
+    return rez;
+  }
+
+private:
+  BakedArray<Position> _waypoints {};
+  BakedArray<float> _distances {};
+};
+} // namespace gabe
@@ -9,137 +9,128 @@
 #include "gameStateIntegrator/Inventory.hpp"
 #include "gameStateIntegrator/Player.hpp"
 #include "gameStateIntegrator/Round.hpp"
+#include "multithreaded/frameRing/FrameRing.hpp"
+#include "multithreaded/seqlock/SeqLock.hpp"
 #include "utils/objectDetection/ObjectDetectionController.hpp"
 #include <cassert>
+#include <functional>
 #include <mutex>
+#include <type_traits>
 #include <types.hpp>
 #include <vector>
 
 namespace gabe {
 
-struct Shared {
-  std::mutex lock;
-};
-
-struct Image {
-  unsigned char* data;
-};
-
-struct SharedPosition : Position, Shared {
-  SharedPosition() = default;
-  explicit SharedPosition(Position const& other) : Position(other) {}
-
-  auto& operator=(Position const& other) {
-    x = other.x;
-    y = other.y;
-    z = other.z;
-    return *this;
-  }
-
-  auto position() const -> Position { return Position {x, y, z}; }
-};
-struct SharedImage : Image, Shared {
-  SharedImage() = default;
-  explicit SharedImage(Image const& other) : Image(other) {}
-
-  auto& operator=(Image&& other) {
-    data = std::exchange(other.data, nullptr);
-    return *this;
-  }
-
-  auto image() -> Image { return Image {data}; }
-};
-struct SharedOrientation : Orientation, Shared {
-  SharedOrientation() : Orientation() {}
-  explicit SharedOrientation(Orientation const& other) : Orientation(other) {}
-
-  auto& operator=(Orientation const& other) {
-    x = other.x;
-    y = other.y;
-    z = other.z;
-    return *this;
-  }
-
-  auto orientation() const -> Orientation { return Orientation {x, y, z}; }
+//everything the decision trees read from the game, published as one value so a reader never mixes two updates
+struct GameStateSnapshot {
+  Position position {};
+  Orientation orientation {};
+  utils::BoundingBox enemy {utils::sentinelBox};
+  Inventory inventory {};
+  Player player {};
+  Round round {};
 };
 
+static_assert(std::is_trivially_copyable_v<GameStateSnapshot>, "Snapshots are published through a seqlock");
 
 class GameState : public JsonUpdatable<GameState> {
 public:
-  enum class Properties { POSITION, ORIENTATION, IMAGE };
+  enum class Properties { POSITION, ORIENTATION, ENEMY };
+
+  //mapFilePath names the navigation file compiled by mapCompiler for the map being played
+  explicit GameState(std::string const& mapFilePath) : map {mapFilePath} {}
+
+  //resource bits used by decision trees to declare which parts of the state they read and write
+  struct Field {
+    static constexpr uint64 POSITION = 1u << 0u;
+    static constexpr uint64 ORIENTATION = 1u << 1u;
+    static constexpr uint64 ENEMY = 1u << 2u;
+    static constexpr uint64 INVENTORY = 1u << 3u;
+    static constexpr uint64 PLAYER = 1u << 4u;
+    static constexpr uint64 ROUND = 1u << 5u;
+    static constexpr uint64 TARGET_ZONE = 1u << 6u;
+    static constexpr uint64 CURRENT_PATH = 1u << 7u;
+    static constexpr uint64 NEXT_POSITION = 1u << 8u;
+  };
 
   template <typename V> auto set(Properties property, V&& value) -> void {
-    auto setter = [&value]<typename T>(T& target) {
-      std::lock_guard lg {target.lock};
-      target = std::forward<V>(value);
-    };
-
-    switch (property) {
-      using enum Properties;
-      case POSITION: {
-        if constexpr (std::is_assignable_v<std::remove_cvref_t<decltype(_position)>, V>) {
-          setter(_position);
+    publish([property, &value](GameStateSnapshot& snapshot) {
+      auto setter = [&value]<typename T>(T& target) {
+        if constexpr (std::is_assignable_v<T&, V>) {
+          target = std::forward<V>(value);
         }
-        break;
-      }
-      case ORIENTATION: {
-        if constexpr (std::is_assignable_v<std::remove_cvref_t<decltype(_orientation)>, V>) {
-          setter(_orientation);
+      };
+
+      switch (property) {
+        using enum Properties;
+        case POSITION: {
+          setter(snapshot.position);
+          break;
         }
-        break;
-      }
-      case IMAGE: {
-        if constexpr (std::is_assignable_v<std::remove_cvref_t<decltype(_image)>, V>) {
-          setter(_image);
+        case ORIENTATION: {
+          setter(snapshot.orientation);
+          break;
+        }
+        case ENEMY: {
+          setter(snapshot.enemy);
+          break;
+        }
+        default: {
+          assert(false && "Attempting to set unknown property");
         }
-        break;
-      }
-      default: {
-        assert(false && "Attempting to set unknown property");
       }
-    }
+    });
   }
 
-  auto position() -> Position {
-    std::lock_guard lockGuard {_position.lock};
-    return _position.position();
-  }
+  //applies several changes as a single update
+  template <typename F> auto publish(F&& change) -> void { _snapshot.modify(std::forward<F>(change)); }
 
-  auto orientation() -> Orientation {
-    std::lock_guard lockGuard {_orientation.lock};
-    return _orientation.orientation();
-  }
+  //consistent view of the whole state; lock free and allocation free
+  [[nodiscard]] auto snapshot() const -> GameStateSnapshot { return _snapshot.load(); }
 
-  auto image() -> Image {
-    std::lock_guard lockGuard {_image.lock};
-    return _image.image();
-  }
-
-  [[nodiscard]] auto inventory() const -> Inventory { return _inventory; }
-  [[nodiscard]] auto player() const -> Player { return _player; }
-  [[nodiscard]] auto round() const -> Round { return _round; }
+  [[nodiscard]] auto position() const -> Position { return snapshot().position; }
+  [[nodiscard]] auto orientation() const -> Orientation { return snapshot().orientation; }
+  [[nodiscard]] auto enemy() const -> utils::BoundingBox { return snapshot().enemy; }
+  [[nodiscard]] auto inventory() const -> Inventory { return snapshot().inventory; }
+  [[nodiscard]] auto player() const -> Player { return snapshot().player; }
+  [[nodiscard]] auto round() const -> Round { return snapshot().round; }
 
+  //server threads integrate concurrently; the parsed parts are published together once all of them succeeded
   auto jsonUpdate(cds::json::JsonObject const& jsonObject) noexcept(false) -> void {
-    _inventory.update(jsonObject);
-    _player.update(jsonObject);
-    _round.update(jsonObject);
+    {
+      std::lock_guard lockGuard {_integrationLock};
+      _inventory.update(jsonObject);
+      _player.update(jsonObject);
+      _round.update(jsonObject);
+      publish([this](GameStateSnapshot& snapshot) {
+        snapshot.inventory = _inventory;
+        snapshot.player = _player;
+        snapshot.round = _round;
+      });
+    }
+    if (_updateListener) {
+      _updateListener();
+    }
   }
 
+  //called after every game state integration update; must be set before the integrator starts
+  auto setUpdateListener(std::function<void()>&& listener) -> void { _updateListener = std::move(listener); }
+
 private:
-  SharedPosition _position {};
-  SharedOrientation _orientation {};
-  SharedImage _image {};
+  SeqLock<GameStateSnapshot> _snapshot {};
+  std::mutex _integrationLock {};
   Inventory _inventory {};
   Player _player {};
   Round _round {};
+  std::function<void()> _updateListener {};
 
 public:
-  Map const map {};
+  Map const map;
+  //screen captures; capturing and detection synchronize through the ring instead of the scheduler
+  FrameRing frames {expectedScreenWidth * expectedScreenHeight * 3};
 
-  Map::NamedZone targetZone {Zone {}, Map::ZoneName::NO_ZONE};
-  std::vector<Zone> currentPath {};
+  Map::ZoneName targetZone {Map::ZoneName::NO_ZONE};
+  std::vector<Map::ZoneId> currentPath {};
   Position nextPosition {};
-
-  utils::BoundingBox enemy {utils::sentinelBox};
 };
 } // namespace gabe
@@ -0,0 +1,134 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "NavigationGrid.hpp"
+#include "types.hpp"
+#include "utils/math/geometry/Geometry.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace gabe {
+//A* over the cells of a navigation grid, 8-connected, towards the closest cell touching any of a set of goal areas.
+//Steps are those of NavigationGrid::forEachStep; stepping onto an inaccessible cell costs blockedPenalty on top of the
+//step length, so a search started inside an obstacle still finds its way out.
+//The per cell arrays are kept between searches and stamped with a search generation, so a search only touches the
+//cells it reaches and nothing is cleared or allocated once the arrays have grown to the largest grid
+class GridSearch {
+public:
+  using Cell = NavigationGrid::Cell;
+
+  static constexpr float blockedPenalty = NavigationGrid::blockedPenalty;
+  static constexpr Cell noCell = ~Cell {0};
+
+  GridSearch() = default;
+  GridSearch(GridSearch const&) = delete;
+  GridSearch(GridSearch&&) noexcept = default;
+
+  auto operator=(GridSearch&&) noexcept -> GridSearch& = default;
+
+  //returns false when no goal cell can be reached
+  auto search(NavigationGrid const& grid, Cell start, std::span<Volume const> goals) -> bool {
+    prepare(grid.size());
+    _goal = noCell;
+    _expanded = 0;
+
+    _heap.clear();
+    open(start, start, 0.0f, heuristic(grid, start, goals));
+    while (!_heap.empty()) {
+      std::ranges::pop_heap(_heap, std::greater {});
+      auto const [estimate, cell] = _heap.back();
+      _heap.pop_back();
+      if (_closed[cell] == _generation) {
+        continue;
+      }
+      _closed[cell] = _generation;
+      ++_expanded;
+
+      auto const volume = grid.volume(cell);
+      if (std::ranges::any_of(goals, [&volume](Volume const& goal) { return goal.intersects(volume); })) {
+        _goal = cell;
+        return true;
+      }
+
+      grid.forEachStep(cell, [&](Cell next, float length) {
+        if (_closed[next] == _generation) {
+          return;
+        }
+        auto const cost = _cost[cell] + length + grid.penalty(next);
+        if (_seen[next] != _generation || cost < _cost[next]) {
+          open(next, cell, cost, cost + heuristic(grid, next, goals));
+        }
+      });
+    }
+    return false;
+  }
+
+  [[nodiscard]] auto goal() const -> Cell { return _goal; }
+  [[nodiscard]] auto cost() const -> float { return _goal == noCell ? 0.0f : _cost[_goal]; }
+  [[nodiscard]] auto parent(Cell cell) const -> Cell { return _parent[cell]; }
+  [[nodiscard]] auto expanded() const -> Size { return _expanded; }
+
+  //the octile distance, in cells, to the closest goal area. A cell touching a goal area lies within half a cell of it
+  //on every axis, which is taken off so that the estimate never exceeds the real cost
+  static auto heuristic(NavigationGrid const& grid, Cell cell, std::span<Volume const> goals) -> float {
+    auto const center = grid.center(cell);
+    auto rez = std::numeric_limits<float>::max();
+    for (auto const& goal : goals) {
+      auto gap = [](float value, float first, float second) {
+        auto const outside = std::max({0.0f, std::min(first, second) - value, value - std::max(first, second)});
+        return std::max(0.0f, outside / NavigationGrid::cellSize - 0.5f);
+      };
+      auto const dx = gap(center.x, goal.firstCorner.x, goal.secondCorner.x);
+      auto const dy = gap(center.y, goal.firstCorner.y, goal.secondCorner.y);
+      rez = std::min(rez, dx + dy + (std::numbers::sqrt2_v<float> - 2.0f) * std::min(dx, dy));
+    }
+    return rez;
+  }
+
+private:
+  struct Entry {
+    float estimate;
+    Cell cell;
+
+    auto operator<=>(Entry const& other) const = default;
+  };
+
+  auto prepare(Size cellCount) -> void {
+    if (_cost.size() < cellCount) {
+      _cost.resize(cellCount);
+      _parent.resize(cellCount);
+      _seen.resize(cellCount, 0);
+      _closed.resize(cellCount, 0);
+    }
+    if (++_generation == 0) {
+      std::ranges::fill(_seen, 0);
+      std::ranges::fill(_closed, 0);
+      _generation = 1;
+    }
+  }
+
+  auto open(Cell cell, Cell parent, float cost, float estimate) -> void {
+    _seen[cell] = _generation;
+    _cost[cell] = cost;
+    _parent[cell] = parent;
+    _heap.push_back({estimate, cell});
+    std::ranges::push_heap(_heap, std::greater {});
+  }
+
+  std::vector<float> _cost {};
+  std::vector<Cell> _parent {};
+  std::vector<uint32> _seen {};
+  std::vector<uint32> _closed {};
+  std::vector<Entry> _heap {};
+  uint32 _generation {};
+  Cell _goal {noCell};
+  Size _expanded {};
+};
+} // namespace gabe
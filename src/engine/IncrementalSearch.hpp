@@ -0,0 +1,213 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "NavigationGrid.hpp"
+#include "types.hpp"
+#include "utils/math/geometry/Geometry.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace gabe {
+//D* Lite over a navigation grid, with the moves and costs of GridSearch. Costs are searched backwards from the goal
+//cells, so when the start moves or cells change accessibility only the costs affected are repaired instead of
+//searching again. The planner works on its own copy of the grid, which is what setAccessible changes
+class IncrementalSearch {
+public:
+  using Cell = NavigationGrid::Cell;
+
+  static constexpr Cell noCell = ~Cell {0};
+
+  IncrementalSearch() = default;
+  IncrementalSearch(IncrementalSearch const&) = delete;
+  IncrementalSearch(IncrementalSearch&&) noexcept = default;
+
+  auto operator=(IncrementalSearch&&) noexcept -> IncrementalSearch& = default;
+
+  //drops every cost; the next plan searches the grid from scratch
+  auto reset(NavigationGrid const& grid, std::span<Volume const> goals) -> void {
+    _grid = grid;
+    _goals.assign(goals.begin(), goals.end());
+    _g.assign(_grid.size(), infinity);
+    _rhs.assign(_grid.size(), infinity);
+    _goal.assign(_grid.size(), false);
+    _queued.assign(_grid.size(), Key {infinity, infinity});
+    _heap.clear();
+    _start = noCell;
+    _keyModifier = 0.0f;
+    for (Cell cell = 0; cell < _grid.size(); ++cell) {
+      auto const volume = _grid.volume(cell);
+      if (std::ranges::any_of(_goals, [&volume](Volume const& goal) { return goal.intersects(volume); })) {
+        _goal[cell] = true;
+        _rhs[cell] = 0.0f;
+      }
+    }
+    _initialised = false;
+  }
+
+  //brings the costs up to date for a search from start; returns false when no goal can be reached from it
+  auto plan(Cell start) -> bool {
+    if (!_initialised) {
+      _start = start;
+      for (Cell cell = 0; cell < _grid.size(); ++cell) {
+        if (_goal[cell]) {
+          push(cell);
+        }
+      }
+      _initialised = true;
+    } else if (start != _start) {
+      _keyModifier += heuristic(_start, start);
+      _start = start;
+    }
+    _expanded = 0;
+    computeCosts();
+    return _rhs[_start] != infinity;
+  }
+
+  auto setAccessible(Cell cell, bool accessible) -> void {
+    if (_grid.accessible(cell) == accessible) {
+      return;
+    }
+    _grid.setAccessible(cell, accessible);
+    if (_initialised) {
+      updateAround(cell);
+    }
+  }
+
+  //the cell to step onto from cell on a cheapest route; noCell on goal cells and where no goal can be reached
+  [[nodiscard]] auto next(Cell cell) const -> Cell {
+    if (_goal[cell]) {
+      return noCell;
+    }
+    auto rez = noCell;
+    auto best = infinity;
+    _grid.forEachStep(cell, [this, &rez, &best](Cell neighbour, float length) {
+      auto const cost = length + _grid.penalty(neighbour) + _g[neighbour];
+      if (cost < best) {
+        best = cost;
+        rez = neighbour;
+      }
+    });
+    return rez;
+  }
+
+  [[nodiscard]] auto cost(Cell cell) const -> float { return _rhs[cell]; }
+  [[nodiscard]] auto goal(Cell cell) const -> bool { return _goal[cell]; }
+  [[nodiscard]] auto grid() const -> NavigationGrid const& { return _grid; }
+  [[nodiscard]] auto goals() const -> std::span<Volume const> { return _goals; }
+  //cells whose cost was settled by the last plan
+  [[nodiscard]] auto expanded() const -> Size { return _expanded; }
+
+private:
+  static constexpr float infinity = std::numeric_limits<float>::infinity();
+
+  using Key = std::pair<float, float>;
+  using Entry = std::pair<Key, Cell>;
+
+  //octile distance in cells; never more than the cost of any route between the two cells
+  [[nodiscard]] auto heuristic(Cell from, Cell to) const -> float {
+    auto const dx = std::abs(static_cast<float>(_grid.line(from)) - static_cast<float>(_grid.line(to)));
+    auto const dy = std::abs(static_cast<float>(_grid.column(from)) - static_cast<float>(_grid.column(to)));
+    return dx + dy + (std::numbers::sqrt2_v<float> - 2.0f) * std::min(dx, dy);
+  }
+
+  [[nodiscard]] auto key(Cell cell) const -> Key {
+    auto const cost = std::min(_g[cell], _rhs[cell]);
+    return {cost + heuristic(_start, cell) + _keyModifier, cost};
+  }
+
+  //the heap keeps stale entries; an entry is live while it matches the key the cell was last queued with
+  auto push(Cell cell) -> void {
+    _queued[cell] = key(cell);
+    _heap.emplace_back(_queued[cell], cell);
+    std::ranges::push_heap(_heap, std::greater {});
+  }
+
+  auto dropStale() -> void {
+    while (!_heap.empty() && _heap.front().first != _queued[_heap.front().second]) {
+      std::ranges::pop_heap(_heap, std::greater {});
+      _heap.pop_back();
+    }
+  }
+
+  auto updateCell(Cell cell) -> void {
+    if (!_goal[cell]) {
+      auto rhs = infinity;
+      _grid.forEachStep(cell, [this, &rhs](Cell neighbour, float length) {
+        rhs = std::min(rhs, length + _grid.penalty(neighbour) + _g[neighbour]);
+      });
+      _rhs[cell] = rhs;
+    }
+    _queued[cell] = {infinity, infinity};
+    if (_g[cell] != _rhs[cell]) {
+      push(cell);
+    }
+  }
+
+  //besides the steps onto the cell, the diagonal steps between its neighbours depend on its accessibility, so the
+  //costs of every cell around it are refreshed
+  auto updateAround(Cell cell) -> void {
+    auto const line = static_cast<long>(_grid.line(cell));
+    auto const column = static_cast<long>(_grid.column(cell));
+    for (long lineStep = -1; lineStep <= 1; ++lineStep) {
+      for (long columnStep = -1; columnStep <= 1; ++columnStep) {
+        auto const nextLine = line + lineStep;
+        auto const nextColumn = column + columnStep;
+        if (nextLine >= 0 && nextColumn >= 0 && nextLine < static_cast<long>(_grid.lines())
+            && nextColumn < static_cast<long>(_grid.columns())) {
+          updateCell(_grid.cell(nextLine, nextColumn));
+        }
+      }
+    }
+  }
+
+  auto computeCosts() -> void {
+    while (true) {
+      dropStale();
+      if (_heap.empty()) {
+        return;
+      }
+      auto const [queuedKey, cell] = _heap.front();
+      if (queuedKey >= key(_start) && _rhs[_start] == _g[_start]) {
+        return;
+      }
+      std::ranges::pop_heap(_heap, std::greater {});
+      _heap.pop_back();
+      _queued[cell] = {infinity, infinity};
+
+      if (auto const current = key(cell); queuedKey < current) {
+        push(cell);
+      } else if (_g[cell] > _rhs[cell]) {
+        _g[cell] = _rhs[cell];
+        ++_expanded;
+        _grid.forEachStep(cell, [this](Cell neighbour, float) { updateCell(neighbour); });
+      } else {
+        _g[cell] = infinity;
+        ++_expanded;
+        _grid.forEachStep(cell, [this](Cell neighbour, float) { updateCell(neighbour); });
+        updateCell(cell);
+      }
+    }
+  }
+
+  NavigationGrid _grid {};
+  std::vector<Volume> _goals {};
+  std::vector<float> _g {};
+  std::vector<float> _rhs {};
+  std::vector<bool> _goal {};
+  std::vector<Key> _queued {};
+  std::vector<Entry> _heap {};
+  Cell _start {noCell};
+  float _keyModifier {};
+  bool _initialised {false};
+  Size _expanded {};
+};
+} // namespace gabe
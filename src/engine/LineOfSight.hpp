@@ -0,0 +1,67 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "types.hpp"
+#include "utils/math/geometry/Geometry.hpp"
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace gabe {
+//Whether a point can be seen from another, judged on the ground plane as navigation grids are: the segment between
+//them is cast against the footprints of the map's obstacles, leaving out those under either of its ends. Zones only
+//roughly cover open ground, so the segment may leave them
+class LineOfSight {
+public:
+  LineOfSight() = delete;
+  LineOfSight(LineOfSight const&) = default;
+  LineOfSight(LineOfSight&&) noexcept = default;
+
+  explicit LineOfSight(std::span<Volume const> obstacles) : _obstacles {obstacles.begin(), obstacles.end()} {}
+
+  auto operator=(LineOfSight const&) -> LineOfSight& = default;
+  auto operator=(LineOfSight&&) noexcept -> LineOfSight& = default;
+
+  [[nodiscard]] auto visible(Position const& from, Position const& to) const -> bool {
+    auto const length = std::sqrt(from.distanceXY(to));
+    return std::ranges::none_of(_obstacles, [&](Volume const& obstacle) {
+      auto const [entry, exit] = overlap(from, to, obstacle);
+      return (exit - entry) * length > epsilon && !obstacle.containsInXY(from) && !obstacle.containsInXY(to);
+    });
+  }
+
+private:
+  static constexpr float epsilon = 1e-3f;
+
+  //the part of the segment over the volume as fractions [entry, exit] of its length; entry > exit when there is none
+  static auto overlap(Position const& from, Position const& to, Volume const& volume) -> std::pair<float, float> {
+    auto entry = 0.0f;
+    auto exit = 1.0f;
+    auto clip = [&entry, &exit](float start, float end, float first, float second) {
+      auto const lower = std::min(first, second);
+      auto const upper = std::max(first, second);
+      auto const delta = end - start;
+      if (std::abs(delta) < epsilon) {
+        if (start < lower || start > upper) {
+          exit = -1.0f;
+        }
+        return;
+      }
+      auto const lowerAt = (lower - start) / delta;
+      auto const upperAt = (upper - start) / delta;
+      entry = std::max(entry, std::min(lowerAt, upperAt));
+      exit = std::min(exit, std::max(lowerAt, upperAt));
+    };
+    clip(from.x, to.x, volume.firstCorner.x, volume.secondCorner.x);
+    clip(from.y, to.y, volume.firstCorner.y, volume.secondCorner.y);
+    return {entry, exit};
+  }
+
+  std::vector<Volume> _obstacles;
+};
+} // namespace gabe
@@ -4,60 +4,37 @@
 
 #pragma once
 
+#include "Adjacency.hpp"
+#include "BakedArray.hpp"
+#include "FlowField.hpp"
+#include "LineOfSight.hpp"
+#include "NavFile.hpp"
+#include "NavigationGrid.hpp"
+#include "ZoneIndex.hpp"
+#include "utils/file/MappedFile.hpp"
 #include "utils/math/geometry/Geometry.hpp"
+#include "utils/random/AliasTable.hpp"
 #include <algorithm>
-#include <map>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
 #include <types.hpp>
 #include <vector>
 
 namespace gabe {
 
 struct Zone {
-  struct SubZone {
-    Volume volume;
-    bool accessible {true};
-    std::pair<int, int> indices {};
-
-    auto operator<=>(SubZone const& other) const { return volume.operator<=>(other.volume); }
-    auto operator!=(SubZone const& other) const -> bool { return volume != other.volume; }
-  };
-
   Volume volume;
   std::vector<Volume> obstacles {};
   std::vector<Volume> hidingSpots {};
 
   auto operator<=>(Zone const& other) const { return volume.operator<=>(other.volume); }
   auto operator==(Zone const& other) const -> bool { return volume == other.volume; }
-  [[nodiscard]] auto subzones() const -> std::vector<std::vector<SubZone>> {
-    std::vector<std::vector<SubZone>> result {};
-    static constexpr auto subzoneRatio = 10;
-    auto lowerCorner = Position {std::min(volume.firstCorner.x, volume.secondCorner.x),
-                                 std::min(volume.firstCorner.y, volume.secondCorner.y),
-                                 std::min(volume.firstCorner.z, volume.secondCorner.z)};
-    auto upperCorner = Position {std::max(volume.firstCorner.x, volume.secondCorner.x),
-                                 std::max(volume.firstCorner.y, volume.secondCorner.y),
-                                 std::max(volume.firstCorner.z, volume.secondCorner.z)};
-    int i = 0;
-    for (auto x = lowerCorner.x; x < upperCorner.x; x += subzoneRatio, ++i) {
-      auto tempResult = std::vector<SubZone> {};
-      int j = 0;
-      for (auto y = lowerCorner.y; y < upperCorner.y; y += subzoneRatio, ++j) {
-        auto newVolume = Volume {
-            {x, y, lowerCorner.z},
-            {std::min(x + subzoneRatio, upperCorner.x), std::min(y + subzoneRatio, upperCorner.y), upperCorner.z}};
-        bool accessible = true;
-        for (auto const& ob : obstacles) {
-          if (newVolume.intersects(ob)) {
-            accessible = false;
-            break;
-          }
-        }
-        tempResult.emplace_back(newVolume, accessible, std::pair<int, int> {i, j});
-      }
-      result.emplace_back(tempResult);
-    }
-    return result;
-  }
 };
 
 class Map {
@@ -90,7 +67,10 @@ public:
     SHORT_ABOVE_CT,
     SHORT_TO_A
   };
+  static constexpr Size zoneNameCount = static_cast<Size>(ZoneName::SHORT_TO_A) + 1;
   enum class RequiredMovement { NONE, JUMP, JUMP_AND_CROUCH, RUN_AND_JUMP };
+  //what routes between zones minimise: the number of zones crossed or the distance between their centers
+  enum class RouteCost { HOPS, DISTANCE };
   struct NamedZone {
     Zone zone;
     ZoneName name;
@@ -182,304 +162,482 @@ public:
       }
     }
   };
+  using ZoneId = ZoneIndex::ZoneId;
+  static constexpr ZoneId noZone = std::numeric_limits<ZoneId>::max();
+
   struct Transition {
-    Zone zone;
+    ZoneId zone;
     RequiredMovement movement;
     Volume transitionArea {};
   };
 
-  Map() {
-    buildZones();
-    buildZoneTransitions();
-    buildZoneWatchpoints();
-  }
+  //a way out of a zone into a neighbour, one per transition; the nodes of the map's abstract route graph
+  using PortalId = uint16;
+  static constexpr PortalId noPortal = std::numeric_limits<PortalId>::max();
+  struct Portal {
+    PortalId id;
+    ZoneId from;
+    ZoneId to;
+    Volume area;
+    //the cell of to's navigation grid the portal leads into
+    NavigationGrid::Cell entry;
+  };
+  //taking a portal out of the zone another one led into, from the entry of the latter
+  struct PortalStep {
+    PortalId portal;
+    float cost;
+  };
+  //a watchpoint seen from a navigation cell, as a column of the alias table over the priorities of all of them
+  struct Sightline {
+    Position target;
+    float probability;
+    uint32 alias;
+  };
 
-  auto findZone(Position const& position) const -> NamedZone {
-    auto zoneCompare = [position](NamedZone const& z1, NamedZone const& z2) {
-      return z1.zone.volume.distance(position) < z2.zone.volume.distance(position);
+  //what a map is compiled from; parseMapDescription reads it from the text form kept in data/maps
+  struct Description {
+    struct Transition {
+      ZoneName start;
+      ZoneName target;
+      RequiredMovement movement {RequiredMovement::NONE};
+      bool oneWay {false};
+      Volume area {};
+    };
+    struct Watchpoint {
+      ZoneName zone;
+      Position target;
+      //how often the watchpoint is aimed at, relative to the others seen from the same place
+      float priority {1.0f};
     };
-    return *std::ranges::min_element(_zones.begin(), _zones.end(), zoneCompare);
-  }
 
-  auto getZoneByName(ZoneName zoneName) const -> NamedZone {
-    return *std::ranges::find(_zones.begin(), _zones.end(), zoneName, [](NamedZone const& z) { return z.name; });
-  }
+    std::vector<NamedZone> zones {};
+    std::vector<Transition> transitions {};
+    std::vector<Watchpoint> watchpoints {};
+  };
 
-  auto getZoneByVolume(Zone const& zone) const -> NamedZone {
-    return *std::ranges::find(_zones.begin(), _zones.end(), zone, [](NamedZone const& z) { return z.zone; });
+  //compiles a map, baking its zone index, navigation grids, routes, flow fields and portals
+  explicit Map(Description const& description, RouteCost routeCost = RouteCost::HOPS) {
+    buildZones(description);
+    buildZoneIndex();
+    buildNavigationGrids();
+    buildZoneTransitions(description);
+    buildZoneWatchpoints(description);
+    buildSightlines(description);
+    buildRoutes(routeCost);
+    buildFlowFields();
+    buildPortals();
   }
 
-  [[nodiscard]] auto const& transitions() const { return _transitions; }
-
-  [[nodiscard]] auto possibleTransitions(Zone const& startZone, Zone const& targetZone) const
-      -> std::vector<Transition> {
-    std::vector<Transition> result {};
-    for (auto const& transition : _transitions.at(startZone)) {
-      if (transition.zone == targetZone) {
-        result.push_back(transition);
-      }
+  //maps a navigation file saved from a compiled map; the baked tables are read in place, so only the zones are copied
+  explicit Map(std::string const& navFilePath) noexcept(false) :
+      _file {std::make_shared<utils::file::MappedFile const>(navFilePath)} {
+    nav::Reader reader {_file->bytes(), navFilePath};
+    readZones(reader);
+    _zoneIndex = ZoneIndex::read(reader);
+    reader.expect(_zoneIndex.size() == _zones.size());
+    for (Size zone = 0; zone < _zones.size(); ++zone) {
+      _navigationGrids.push_back(NavigationGrid::read(reader));
+    }
+    _transitions = Adjacency<Transition>::read(reader, _zones.size());
+    _watchPoints = Adjacency<Position>::read(reader, _zones.size());
+    indexCells();
+    _sightlines = Adjacency<Sightline>::read(reader, _firstCells.back());
+    for (uint32 cell = 0; cell < _firstCells.back(); ++cell) {
+      auto const sightlines = _sightlines[cell];
+      reader.expect(std::ranges::all_of(sightlines, [&sightlines](uint32 alias) { return alias < sightlines.size(); },
+                                        &Sightline::alias));
+    }
+    auto const knownZone = [this](ZoneId id) { return id < _zones.size(); };
+    for (ZoneId zone = 0; zone < _zones.size(); ++zone) {
+      reader.expect(std::ranges::all_of(transitions(zone), knownZone, &Transition::zone));
     }
-    return result;
-  }
-
-  [[nodiscard]] auto watchpoints(Zone const& zone) const -> std::vector<Position> { return _watchPoints.at(zone); }
-
-private:
-  auto buildZones() -> void {
-    using enum ZoneName;
-    NamedZone tSpawn {Zone {Position {-1176.63f, -665.08f, 187.94f}, Position {439.72f, -999.97f, 67.21f}}, T_SPAWN};
-    tSpawn.zone.obstacles.emplace_back(Position {-878.56f, -722.03f, 186.22f}, Position {-982.03f, -638.03f, 192.16f});
-    _zones.push_back(tSpawn);
-
-    NamedZone tSpawnExit {Zone {Position {375.97f, -500.48f, 63.87f}, Position {-491.97f, -634.46f, 221.34f}},
-                          T_SPAWN_EXIT};
-    _zones.push_back(tSpawnExit);
-
-    NamedZone tSpawnToLong {Zone {Position {111.07f, -481.46f, 63.8f}, Position {747.97f, 235.97f, 72.28f}},
-                            T_SPAWN_TO_LONG};
-    tSpawnToLong.zone.obstacles.emplace_back(Position {375.97f, -499.79f, 63.87f},
-                                             Position {572.03f, -370.01f, 74.45f});
-    tSpawnToLong.zone.obstacles.emplace_back(Position {148.03f, -182.03f, 71.87f}, Position {211.8f, 19.62f, 69.4f});
-    tSpawnToLong.zone.obstacles.emplace_back(Position {124.08f, 101.10f, 73.1f}, Position {170.13f, 39.09f, 71.09f});
-    tSpawnToLong.zone.obstacles.emplace_back(Position {734.93f, -168.89f, 71.0f}, Position {598.21f, 51.49f, 60.32f});
-    tSpawnToLong.zone.obstacles.emplace_back(Position {144.76f, -276.f, 64.72f}, Position {106.05f, -23.17f, 86.51f});
-    _zones.push_back(tSpawnToLong);
-
-    NamedZone tDoors {Zone {Position {584.03f, 261.05f, 63.74f}, Position {700.69f, 339.08f, 64.48f}}, T_DOORS};
-    tDoors.zone.obstacles.emplace_back(Position {639.4f, 359.03f, 64.79f}, Position {584.03f, 276.99f, 64.63f});
-    tDoors.zone.obstacles.emplace_back(Position {639.0f, 236.97f, 63.07f}, Position {722.13f, 305.93f, 58.73f});
-    _zones.push_back(tDoors);
-
-    NamedZone doorsCorridor {Zone {Position {539.03f, 346.59f, 65.31f}, Position {733.76f, 707.08f, 71.95f}},
-                             DOORS_CORRIDOR};
-    doorsCorridor.zone.obstacles.emplace_back(Position {733.76f, 707.08f, 71.95f}, Position {653.11f, 574.38f, 64.6f});
-    _zones.push_back(doorsCorridor);
-
-    NamedZone longDoors {Zone {Position {568.17f, 693.9f, 64.99f}, Position {708.52f, 794.57f, 63.9f}}, LONG_DOORS};
-    _zones.push_back(longDoors);
-
-    NamedZone outsideDoorsLong {Zone {Position {516.03f, 808.03f, 65.79f}, Position {1247.34f, 1195.97f, 64.02f}},
-                                OUTSIDE_DOORS_LONG};
-    outsideDoorsLong.zone.obstacles.emplace_back(Position {700.11f, 1081.83f, 64.61f},
-                                                 Position {925.3f, 1214.82f, 100.03f});
-    outsideDoorsLong.zone.obstacles.emplace_back(Position {925.3f, 1214.82f, 100.03f},
-                                                 Position {984.85f, 1123.97f, 64.55f});
-    outsideDoorsLong.zone.obstacles.emplace_back(Position {860.03f, 801.89f, 64.15f},
-                                                 Position {795.97f, 808.03f, 63.87f});
-    _zones.push_back(outsideDoorsLong);
-
-    NamedZone nearDoorsLong {Zone {Position {968.03f, 215.03f, 75.7f}, Position {1227.96f, 769.19f, 71.39f}},
-                             NEAR_DOORS_LONG};
-    _zones.push_back(nearDoorsLong);
-
-    NamedZone pit {Zone {Position {1292.03f, 741.21f, 48.86f}, Position {1571.97f, 201.03f, -117.03f}}, PIT};
-    _zones.push_back(pit);
-
-    NamedZone farLong {Zone {Position {1271.77f, 804.34f, 60.56f}, Position {1593.97f, 1662.56f, 63.64f}}, FAR_LONG};
-    _zones.push_back(farLong);
-
-    NamedZone aSiteLong {Zone {Position {1593.97f, 1662.56f, 63.64f}, Position {1300.03f, 2302.24f, 77.80f}},
-                         A_SITE_LONG};
-    _zones.push_back(aSiteLong);
-
-    NamedZone ramp {Zone {Position {1601.38f, 2306.24f, 68.40f}, Position {1300.11f, 2772.2f, 179.13f}}, RAMP};
-    _zones.push_back(ramp);
-
-    NamedZone topOfRamp {Zone {Position {1561.97f, 3059.97f, 190.74f}, Position {1311.11f, 2772.2f, 179.13f}},
-                         TOP_OF_RAMP};
-    _zones.push_back(topOfRamp);
-
-    NamedZone goose {Zone {Position {1295.53f, 2632.93f, 190.36f}, Position {1051.03f, 3059.86f, 193.89f}}, GOOSE};
-    goose.zone.hidingSpots.emplace_back(Position {1051.24f, 3059.97f, 193.89f}, Position {1103.35f, 2969.1f, 192.24f});
-    _zones.push_back(goose);
-
-    NamedZone aSite {Zone {Position {1249.08f, 2616.88f, 190.6f}, Position {1056.03f, 2347.07f, 190.53f}}, A_SITE};
-    aSite.zone.obstacles.emplace_back(Position {1265.55f, 2561.03f, 190.87f}, Position {1176.88f, 2460.97f, 159.96f});
-    aSite.zone.obstacles.emplace_back(Position {1097.64f, 2575.82f, 160.12f}, Position {989.21f, 2411.97f, 191.09f});
-    _zones.push_back(aSite);
-
-    NamedZone topMid {Zone {Position {-391.77f, -444.87f, 64.98f}, Position {-491.97f, 189.88f, 65.03f}}, TOP_MID};
-    topMid.zone.obstacles.emplace_back(Position {-425.54f, -43.97f, 62.81f}, Position {-491.97f, -228.03f, 640.06f});
-    _zones.push_back(topMid);
-
-    NamedZone tSpawnToMid {Zone {Position {-60.08f, 457.97f, 63.05f}, Position {447.79f, 260.12f, 65.53f}},
-                           T_SPAWN_TO_MID};
-    _zones.push_back(tSpawnToMid);
-
-    NamedZone bunelu {Zone {Position {-511.01f, 212.03f, 66.21f}, Position {-621.97f, 627.97f, 72.09f}}, BUNELU};
-    _zones.push_back(bunelu);
-
-    NamedZone outsideTopMid {Zone {Position {-77.02f, 308.03f, 64.33f}, Position {-493.39f, 553.24f, 63.69f}},
-                             OUTSIDE_TOP_MID};
-    _zones.push_back(outsideTopMid);
-
-    NamedZone midToShort {Zone {Position {-493.39f, 553.24f, 63.69f}, Position {-149.03f, 751.5f, 65.77f}},
-                          MID_TO_SHORT};
-    midToShort.zone.obstacles.emplace_back(Position {-171.09f, 539.17f, 63.63f}, Position {-258.75f, 582.25f, 64.16f});
-    _zones.push_back(midToShort);
-
-
-    NamedZone tToShort {Zone {Position {-149.03f, 767.47f, 66.06f}, Position {-211.97f, 1516.97f, 64.54f}}, T_TO_SHORT};
-    _zones.push_back(tToShort);
-
-    NamedZone shortCorridor {Zone {Position {489.97f, 1539.69f, 64.58f}, Position {-132.02f, 1361.89f, 63.67f}},
-                             SHORT_CORRIDOR};
-    _zones.push_back(shortCorridor);
-
-    NamedZone shortStairs {Zone {Position {273.03f, 1539.66f, 66.12f}, Position {489.97f, 1943.97f, 159.87f}},
-                           SHORT_STAIRS};
-    _zones.push_back(shortStairs);
-
-
-    NamedZone shortAboveCt {Zone {Position {305.82f, 1970.14f, 162.21f}, Position {503.72f, 2444.03f, 159.83f}},
-                            SHORT_ABOVE_CT};
-    shortAboveCt.zone.obstacles.emplace_back(Position {411.97f, 1952.03f, 160.0f}, Position {494.18f, 2052.0f, 160.0f});
-    _zones.push_back(shortAboveCt);
-
 
-    NamedZone shortToA {Zone {Position {278.03f, 2437.36f, 161.86f}, Position {982.2f, 2762.22f, 163.58f}}, SHORT_TO_A};
-    shortToA.zone.obstacles.emplace_back(Position {563.97f, 2697.82f, 160.4f}, Position {752.03f, 2763.97f, 161.62f});
-    shortToA.zone.obstacles.emplace_back(Position {833.73f, 2676.38f, 159.51f}, Position {904.25f, 2763.97f, 163.73f});
-    _zones.push_back(shortToA);
+    _nextHops = reader.array<ZoneId>();
+    _routeCosts = reader.array<float>();
+    reader.expect(_nextHops.size() == _zones.size() * _zones.size() && _routeCosts.size() == _nextHops.size());
+    reader.expect(std::ranges::all_of(_nextHops.items(), [&](ZoneId id) { return knownZone(id) || id == noZone; }));
+    for (Size idx = 0; idx < _nextHops.size(); ++idx) {
+      auto const& field = _flowFields.emplace_back(FlowField::read(reader));
+      auto const zone = static_cast<ZoneId>(idx % _zones.size());
+      auto const neighbour = !possibleTransitions(zone, static_cast<ZoneId>(idx / _zones.size())).empty();
+      reader.expect(neighbour ? field.size() == _navigationGrids[zone].size() : field.empty());
+    }
 
-    std::ranges::for_each(_zones, [this](NamedZone const& zone) { _transitions[zone.zone] = {}; });
+    _portals = reader.array<Portal>();
+    _portalOffsets = reader.array<uint32>();
+    reader.expect(_portalOffsets.size() == _zones.size() + 1 && _portalOffsets[0] == 0
+                  && std::ranges::is_sorted(_portalOffsets.items())
+                  && _portalOffsets[_zones.size()] == _portals.size());
+    for (auto const& portal : _portals.items()) {
+      reader.expect(knownZone(portal.from) && knownZone(portal.to)
+                    && portal.entry < _navigationGrids[portal.to].size());
+      auto const& field = _portalFields.emplace_back(FlowField::read(reader));
+      reader.expect(field.size() == _navigationGrids[portal.from].size());
+    }
+    _portalSteps = Adjacency<PortalStep>::read(reader, _portals.size());
+    for (auto const& portal : _portals.items()) {
+      reader.expect(std::ranges::all_of(portalSteps(portal.id), [this](PortalId id) { return id < _portals.size(); },
+                                        &PortalStep::portal));
+    }
+    reader.finish();
   }
 
-  auto buildZoneTransitions() -> void {
-    using enum ZoneName;
-    using enum RequiredMovement;
-    addTransition(T_SPAWN, T_SPAWN_EXIT, JUMP, true, {{-507.37f, -661.95f, 184.66f}, {-432.93f, -660.03f, 69.35f}});
-    addTransition(T_SPAWN, T_SPAWN_EXIT, NONE, false, {{25.8f, -660.37f, 68.14f}, {321.43f, -665.32f, 62.87f}});
-
-    addTransition(T_SPAWN_EXIT, T_SPAWN_TO_LONG);
-    addTransition(T_SPAWN_EXIT, TOP_MID);
-
-    addTransition(T_SPAWN_TO_LONG, T_DOORS, NONE, false, {{576.74f, 248.7f, 63.1f}, {622.43f, 249.67f, 63.33f}});
-    addTransition(T_SPAWN_TO_LONG, T_SPAWN_TO_MID);
-
-    addTransition(T_DOORS, DOORS_CORRIDOR, NONE, false, {{740.97f, 365.5f, 64.26f}, {651.21f, 322.24f, 64.75f}});
-
-    addTransition(DOORS_CORRIDOR, LONG_DOORS, NONE, false, {{629.97f, 705.0f, 64.65f}, {566.55f, 702.553f, 64.99f}});
-
-    addTransition(LONG_DOORS, OUTSIDE_DOORS_LONG, NONE, false, {{650.03f, 790.3f, 64.26f}, {698.7f, 784.7f, 64.06f}});
-
-    addTransition(OUTSIDE_DOORS_LONG, NEAR_DOORS_LONG);
-    addTransition(OUTSIDE_DOORS_LONG, FAR_LONG);
+  //writes what was baked into the map to a navigation file; false when the file could not be written
+  [[nodiscard]] auto save(std::string const& navFilePath) const -> bool {
+    nav::Writer writer {navFilePath};
+    writeZones(writer);
+    _zoneIndex.write(writer);
+    for (auto const& grid : _navigationGrids) {
+      grid.write(writer);
+    }
+    _transitions.write(writer);
+    _watchPoints.write(writer);
+    _sightlines.write(writer);
+    writer.array(_nextHops);
+    writer.array(_routeCosts);
+    for (auto const& field : _flowFields) {
+      field.write(writer);
+    }
+    writer.array(_portals);
+    writer.array(_portalOffsets);
+    for (auto const& field : _portalFields) {
+      field.write(writer);
+    }
+    _portalSteps.write(writer);
+    return writer.good();
+  }
 
-    addTransition(NEAR_DOORS_LONG, PIT, JUMP, true, {{1226.97f, 342.84f, 72.75f}, {1228.97f, 743.17f, 71.3f}});
+  //nearest zone to the position, zones containing it first; ties go to the earliest built zone
+  [[nodiscard]] auto findZoneId(Position const& position) const -> ZoneId { return _zoneIndex.nearest(position); }
 
-    addTransition(FAR_LONG, A_SITE_LONG);
-    addTransition(FAR_LONG, PIT);
+  [[nodiscard]] auto zone(ZoneId id) const -> NamedZone const& { return _zones[id]; }
+  [[nodiscard]] auto zoneCount() const -> Size { return _zones.size(); }
 
-    addTransition(A_SITE_LONG, RAMP);
+  [[nodiscard]] auto zoneId(ZoneName name) const -> ZoneId { return _idsByName[static_cast<Size>(name)]; }
 
-    //addTransition(RAMP, A_SITE, JUMP_AND_CROUCH, true, {{1300.0f, 2481.87f, 128.46f}, {1300.0f, 2665.0f, 161.46f}});
-    addTransition(RAMP, A_SITE, NONE, true, {{1265.45f, 2808.3f, 190.87f}, {1300.52f, 2705.18f, 170.19f}});
-    addTransition(RAMP, TOP_OF_RAMP);
+  //the zone to move to from start on a cheapest route to target; noZone when target cannot be reached
+  [[nodiscard]] auto nextHop(ZoneId start, ZoneId target) const -> ZoneId {
+    return _nextHops[start * _zones.size() + target];
+  }
+  [[nodiscard]] auto routeCost(ZoneId start, ZoneId target) const -> float {
+    return _routeCosts[start * _zones.size() + target];
+  }
 
-    addTransition(TOP_OF_RAMP, GOOSE);
+  [[nodiscard]] auto navigationGrid(ZoneId id) const -> NavigationGrid const& { return _navigationGrids[id]; }
 
-    addTransition(GOOSE, A_SITE);
+  [[nodiscard]] auto findZone(Position const& position) const -> NamedZone const& { return zone(findZoneId(position)); }
 
-    addTransition(A_SITE, RAMP, JUMP, true, {{1235.9f, 2460.97f, 160.79f}, {1235.97f, 2348.03f, 162.14f}});
+  [[nodiscard]] auto transitions(ZoneId zone) const -> std::span<Transition const> { return _transitions[zone]; }
 
-    addTransition(TOP_MID, BUNELU);
-    addTransition(TOP_MID, OUTSIDE_TOP_MID);
+  //transitions of a zone are ordered by the zone they lead to, so the ones between two zones are adjacent
+  [[nodiscard]] auto possibleTransitions(ZoneId startZone, ZoneId targetZone) const -> std::span<Transition const> {
+    auto const transitions = _transitions[startZone];
+    auto const [first, last] = std::ranges::equal_range(transitions, targetZone, {}, &Transition::zone);
+    return {first, last};
+  }
 
-    addTransition(OUTSIDE_TOP_MID, MID_TO_SHORT);
-    addTransition(OUTSIDE_TOP_MID, BUNELU);
+  [[nodiscard]] auto watchpoints(ZoneId zone) const -> std::span<Position const> { return _watchPoints[zone]; }
 
-    addTransition(T_SPAWN_TO_MID, OUTSIDE_TOP_MID);
+  //the watchpoints of a zone in sight from one of its navigation cells
+  [[nodiscard]] auto sightlines(ZoneId zone, NavigationGrid::Cell cell) const -> std::span<Sightline const> {
+    return _sightlines[_firstCells[zone] + cell];
+  }
 
-    addTransition(MID_TO_SHORT, T_TO_SHORT);
+  //a watchpoint in sight from the cell, drawn in constant time in proportion to its priority
+  template <typename Generator>
+  [[nodiscard]] auto sampleWatchpoint(ZoneId zone, NavigationGrid::Cell cell, Generator& generator) const
+      -> std::optional<Position> {
+    auto const candidates = sightlines(zone, cell);
+    if (candidates.empty()) {
+      return std::nullopt;
+    }
+    auto const& column = candidates[generator.bounded(candidates.size())];
+    return generator.template canonical<float>() < column.probability ? column.target
+                                                                       : candidates[column.alias].target;
+  }
 
-    addTransition(T_TO_SHORT, SHORT_CORRIDOR);
+  //the areas through which a zone is left towards a neighbour; their common region when no transition has an area
+  auto transitionAreas(ZoneId startZone, ZoneId targetZone, std::vector<Volume>& into) const -> void {
+    into.clear();
+    for (auto const& transition : possibleTransitions(startZone, targetZone)) {
+      if (!transition.transitionArea.empty()) {
+        into.push_back(transition.transitionArea);
+      }
+    }
+    if (into.empty()) {
+      into.push_back(_zones[startZone].zone.volume.commonRegion(_zones[targetZone].zone.volume));
+    }
+  }
 
-    addTransition(SHORT_CORRIDOR, SHORT_STAIRS, NONE, true, {{273.03f, 1625.75f, 67.71f}, {404.02f, 1622.72f, 68.89f}});
+  [[nodiscard]] auto portalCount() const -> Size { return _portals.size(); }
+  [[nodiscard]] auto portal(PortalId id) const -> Portal const& { return _portals[id]; }
+  [[nodiscard]] auto portals(ZoneId zone) const -> std::span<Portal const> {
+    return _portals.items().subspan(_portalOffsets[zone], _portalOffsets[zone + 1] - _portalOffsets[zone]);
+  }
+  //directions over the grid of the portal's zone towards it, with the cost from every cell
+  [[nodiscard]] auto portalField(PortalId id) const -> FlowField const& { return _portalFields[id]; }
+  [[nodiscard]] auto portalSteps(PortalId id) const -> std::span<PortalStep const> { return _portalSteps[id]; }
 
-    addTransition(SHORT_STAIRS, SHORT_ABOVE_CT);
+  //directions over the grid of a zone into a neighbouring target; empty unless a transition leads from zone to target
+  [[nodiscard]] auto flowField(ZoneId target, ZoneId zone) const -> FlowField const& {
+    return _flowFields[target * _zones.size() + zone];
+  }
 
-    addTransition(SHORT_ABOVE_CT, SHORT_TO_A);
+private:
+  //how zones are kept in navigation files, with the obstacles and hiding spots of all zones in two arrays after them
+  struct ZoneRecord {
+    ZoneName name;
+    Volume volume;
+    uint32 obstacleCount;
+    uint32 hidingSpotCount;
+  };
 
-    addTransition(SHORT_TO_A, A_SITE);
+  auto buildZones(Description const& description) -> void {
+    assert(!description.zones.empty() && description.zones.size() < noZone && "Unsupported zone count");
+    _zones = description.zones;
+    indexZoneNames();
   }
 
-  auto buildZoneWatchpoints() -> void {
-    using enum ZoneName;
-    for (auto const& zone : _zones) {
-      _watchPoints[zone.zone] = {};
+  auto indexZoneNames() -> void {
+    _idsByName.fill(noZone);
+    for (ZoneId id = 0; id < _zones.size(); ++id) {
+      _idsByName[static_cast<Size>(_zones[id].name)] = id;
     }
+  }
 
-    addWatchpoint(T_SPAWN_TO_LONG, BUNELU);
-    addWatchpoint(T_SPAWN_TO_LONG, T_SPAWN_TO_MID);
-
-    addWatchpoint(DOORS_CORRIDOR, T_DOORS);
+  auto writeZones(nav::Writer& writer) const -> void {
+    std::vector<ZoneRecord> records {};
+    std::vector<Volume> obstacles {};
+    std::vector<Volume> hidingSpots {};
+    for (auto const& [zone, name] : _zones) {
+      records.push_back({name, zone.volume, static_cast<uint32>(zone.obstacles.size()),
+                         static_cast<uint32>(zone.hidingSpots.size())});
+      obstacles.insert(obstacles.end(), zone.obstacles.begin(), zone.obstacles.end());
+      hidingSpots.insert(hidingSpots.end(), zone.hidingSpots.begin(), zone.hidingSpots.end());
+    }
+    writer.array(std::span<ZoneRecord const> {records});
+    writer.array(std::span<Volume const> {obstacles});
+    writer.array(std::span<Volume const> {hidingSpots});
+  }
 
-    addWatchpoint(LONG_DOORS, Position {1391.66f, 1239.72f, 53.08f});
+  auto readZones(nav::Reader& reader) -> void {
+    auto const records = reader.array<ZoneRecord>();
+    auto const obstacles = reader.array<Volume>();
+    auto const hidingSpots = reader.array<Volume>();
+    reader.expect(!records.empty() && records.size() < noZone);
+    Size obstacle {0};
+    Size hidingSpot {0};
+    for (auto const& record : records.items()) {
+      reader.expect(record.name != ZoneName::NO_ZONE && static_cast<Size>(record.name) < zoneNameCount
+                    && record.obstacleCount <= obstacles.size() - obstacle
+                    && record.hidingSpotCount <= hidingSpots.size() - hidingSpot);
+      auto const zoneObstacles = obstacles.items().subspan(obstacle, record.obstacleCount);
+      auto const zoneHidingSpots = hidingSpots.items().subspan(hidingSpot, record.hidingSpotCount);
+      _zones.push_back({Zone {record.volume, {zoneObstacles.begin(), zoneObstacles.end()},
+                              {zoneHidingSpots.begin(), zoneHidingSpots.end()}},
+                        record.name});
+      obstacle += record.obstacleCount;
+      hidingSpot += record.hidingSpotCount;
+    }
+    reader.expect(obstacle == obstacles.size() && hidingSpot == hidingSpots.size());
+    indexZoneNames();
+  }
 
-    addWatchpoint(OUTSIDE_DOORS_LONG, Position {516.34f, 808.03f, 65.62f});
-    addWatchpoint(OUTSIDE_DOORS_LONG, NEAR_DOORS_LONG);
+  auto buildZoneIndex() -> void {
+    std::vector<Volume> volumes {};
+    volumes.reserve(_zones.size());
+    for (auto const& namedZone : _zones) {
+      volumes.push_back(namedZone.zone.volume);
+    }
+    _zoneIndex = ZoneIndex {volumes};
+  }
 
-    addWatchpoint(FAR_LONG, A_SITE);
-    addWatchpoint(FAR_LONG, RAMP);
-    addWatchpoint(FAR_LONG, TOP_OF_RAMP);
+  auto buildNavigationGrids() -> void {
+    _navigationGrids.reserve(_zones.size());
+    for (auto const& namedZone : _zones) {
+      _navigationGrids.emplace_back(namedZone.zone.volume, namedZone.zone.obstacles);
+    }
+  }
 
-    addWatchpoint(A_SITE_LONG, A_SITE);
-    addWatchpoint(A_SITE_LONG, RAMP);
-    addWatchpoint(A_SITE_LONG, TOP_OF_RAMP);
-    addWatchpoint(A_SITE_LONG, SHORT_ABOVE_CT);
+  //Floyd-Warshall over the zone graph, keeping the first hop of every cheapest route
+  auto buildRoutes(RouteCost routeCost) -> void {
+    auto const zoneCount = _zones.size();
+
+    std::vector<float> routeCosts(zoneCount * zoneCount, std::numeric_limits<float>::infinity());
+    std::vector<ZoneId> nextHops(zoneCount * zoneCount, noZone);
+    for (ZoneId start = 0; start < zoneCount; ++start) {
+      routeCosts[start * zoneCount + start] = 0.0f;
+      nextHops[start * zoneCount + start] = start;
+      for (auto const& transition : _transitions[start]) {
+        auto const end = transition.zone;
+        auto const cost = routeCost == RouteCost::HOPS
+            ? 1.0f
+            : std::sqrt(_zones[start].zone.volume.center().distanceXY(_zones[end].zone.volume.center()));
+        if (cost < routeCosts[start * zoneCount + end]) {
+          routeCosts[start * zoneCount + end] = cost;
+          nextHops[start * zoneCount + end] = end;
+        }
+      }
+    }
+    for (Size via = 0; via < zoneCount; ++via) {
+      for (Size start = 0; start < zoneCount; ++start) {
+        for (Size target = 0; target < zoneCount; ++target) {
+          auto const cost = routeCosts[start * zoneCount + via] + routeCosts[via * zoneCount + target];
+          if (cost < routeCosts[start * zoneCount + target]) {
+            routeCosts[start * zoneCount + target] = cost;
+            nextHops[start * zoneCount + target] = nextHops[start * zoneCount + via];
+          }
+        }
+      }
+    }
+    _routeCosts = BakedArray {std::move(routeCosts)};
+    _nextHops = BakedArray {std::move(nextHops)};
+  }
 
-    addWatchpoint(RAMP, FAR_LONG);
-    addWatchpoint(RAMP, SHORT_TO_A);
-    addWatchpoint(RAMP, GOOSE);
-    addWatchpoint(RAMP, A_SITE);
+  //only the fields towards neighbouring zones are baked: routes further away are followed one zone at a time
+  auto buildFlowFields() -> void {
+    auto const zoneCount = _zones.size();
+    _flowFields.assign(zoneCount * zoneCount, {});
+    std::vector<Volume> goals {};
+    std::vector<float> goalDistances {};
+    for (ZoneId zone = 0; zone < zoneCount; ++zone) {
+      for (auto const& transition : _transitions[zone]) {
+        auto& field = _flowFields[transition.zone * zoneCount + zone];
+        if (!field.empty()) {
+          continue;
+        }
+        transitionAreas(zone, transition.zone, goals);
+        goalDistances.assign(goals.size(), 0.0f);
+        field = FlowField {_navigationGrids[zone], goals, goalDistances};
+      }
+    }
+  }
 
-    addWatchpoint(TOP_OF_RAMP, FAR_LONG);
-    addWatchpoint(TOP_OF_RAMP, SHORT_ABOVE_CT);
-    addWatchpoint(TOP_OF_RAMP, SHORT_STAIRS);
+  //every transition becomes a portal with a flow field over its zone; the cost between two consecutive portals is read
+  //from the second one's field at the cell the first one leads into
+  auto buildPortals() -> void {
+    std::vector<Portal> builtPortals {};
+    std::vector<uint32> portalOffsets(_zones.size() + 1, 0);
+    for (ZoneId zone = 0; zone < _zones.size(); ++zone) {
+      for (auto const& transition : _transitions[zone]) {
+        auto const area = transition.transitionArea.empty()
+            ? _zones[zone].zone.volume.commonRegion(_zones[transition.zone].zone.volume)
+            : transition.transitionArea;
+        auto const entry = _navigationGrids[transition.zone].closestCell(area.center());
+        builtPortals.push_back({static_cast<PortalId>(builtPortals.size()), zone, transition.zone, area, entry});
+        std::array const goals {area};
+        std::array const goalDistances {0.0f};
+        _portalFields.emplace_back(_navigationGrids[zone], goals, goalDistances);
+      }
+      portalOffsets[zone + 1] = static_cast<uint32>(builtPortals.size());
+    }
+    _portals = BakedArray {std::move(builtPortals)};
+    _portalOffsets = BakedArray {std::move(portalOffsets)};
+    for (auto const& portal : _portals.items()) {
+      for (auto const& next : portals(portal.to)) {
+        if (auto const cost = _portalFields[next.id].distance(portal.entry);
+            cost != std::numeric_limits<float>::infinity()) {
+          _portalSteps.add(portal.id, {next.id, cost});
+        }
+      }
+    }
+    _portalSteps.finalize(_portals.size());
+  }
 
-    addWatchpoint(GOOSE, RAMP);
-    addWatchpoint(GOOSE, FAR_LONG);
-    addWatchpoint(GOOSE, A_SITE);
+  auto buildZoneTransitions(Description const& description) -> void {
+    for (auto const& transition : description.transitions) {
+      addTransition(transition);
+    }
+    _transitions.finalize(_zones.size(), [](Transition const& transition) { return transition.zone; });
+  }
 
-    addWatchpoint(A_SITE, FAR_LONG);
-    addWatchpoint(A_SITE, RAMP);
-    addWatchpoint(A_SITE, SHORT_ABOVE_CT);
-    addWatchpoint(A_SITE, SHORT_STAIRS);
+  auto buildZoneWatchpoints(Description const& description) -> void {
+    for (auto const& watchpoint : description.watchpoints) {
+      _watchPoints.add(zoneId(watchpoint.zone), watchpoint.target);
+    }
+    _watchPoints.finalize(_zones.size());
   }
 
-  static auto zoneSelector(NamedZone const& z) { return z.name; }
-
-  auto addTransition(ZoneName start, ZoneName target, RequiredMovement movement = RequiredMovement::NONE,
-                     bool oneWay = false, Volume&& transitionArea = {}) -> void {
-    auto startZone = std::ranges::find(_zones.begin(), _zones.end(), start, zoneSelector);
-    auto endZone = std::ranges::find(_zones.begin(), _zones.end(), target, zoneSelector);
-
-    auto startToTransition = transitionArea.empty()
-        ? transitionArea
-        : transitionArea.join(startZone->zone.volume.commonRegion(transitionArea));
-    _transitions[startZone->zone].emplace_back(endZone->zone, movement, startToTransition);
-    if (!oneWay) {
-      auto endToTransition = transitionArea.empty()
-          ? transitionArea
-          : transitionArea.join(endZone->zone.volume.commonRegion(transitionArea));
-      _transitions[endZone->zone].emplace_back(startZone->zone, movement, endToTransition);
+  //numbers the cells of all navigation grids one zone after the other
+  auto indexCells() -> void {
+    _firstCells.assign(1, 0);
+    for (auto const& grid : _navigationGrids) {
+      _firstCells.push_back(_firstCells.back() + static_cast<uint32>(grid.size()));
     }
   }
 
-  auto addWatchpoint(ZoneName zoneName, Position const& target) -> void {
-    auto zone = std::ranges::find(_zones.begin(), _zones.end(), zoneName, zoneSelector);
-    _watchPoints[zone->zone].emplace_back(target);
+  //every cell of a zone keeps the zone's watchpoints in sight from its center, with an alias table over their
+  //priorities laid out along them
+  auto buildSightlines(Description const& description) -> void {
+    indexCells();
+    std::vector<Volume> obstacles {};
+    for (auto const& namedZone : _zones) {
+      obstacles.insert(obstacles.end(), namedZone.zone.obstacles.begin(), namedZone.zone.obstacles.end());
+    }
+    LineOfSight const lineOfSight {obstacles};
+
+    std::vector<Description::Watchpoint> visible {};
+    std::vector<float> priorities {};
+    utils::random::AliasTable table {};
+    for (ZoneId zone = 0; zone < _zones.size(); ++zone) {
+      auto const& grid = _navigationGrids[zone];
+      for (NavigationGrid::Cell cell = 0; cell < grid.size(); ++cell) {
+        auto const center = grid.center(cell);
+        visible.clear();
+        for (auto const& watchpoint : description.watchpoints) {
+          if (zoneId(watchpoint.zone) == zone && watchpoint.priority > 0.0f
+              && lineOfSight.visible(center, watchpoint.target)) {
+            visible.push_back(watchpoint);
+          }
+        }
+        priorities.clear();
+        for (auto const& watchpoint : visible) {
+          priorities.push_back(watchpoint.priority);
+        }
+        table.rebuild(priorities);
+        for (Size idx = 0; idx < visible.size(); ++idx) {
+          _sightlines.add(_firstCells[zone] + cell,
+                          {visible[idx].target, table.probability(idx), static_cast<uint32>(table.alias(idx))});
+        }
+      }
+    }
+    _sightlines.finalize(_firstCells.back());
   }
 
-  auto addWatchpoint(ZoneName zoneName, ZoneName targetZoneName) -> void {
-    auto targetZone = std::ranges::find(_zones.begin(), _zones.end(), targetZoneName, zoneSelector);
-    addWatchpoint(zoneName, targetZone->zone.volume.center());
+  auto addTransition(Description::Transition const& transition) -> void {
+    auto const startZone = zoneId(transition.start);
+    auto const endZone = zoneId(transition.target);
+    auto const& area = transition.area;
+
+    auto startToTransition = area.empty() ? area : area.join(_zones[startZone].zone.volume.commonRegion(area));
+    _transitions.add(startZone, {endZone, transition.movement, startToTransition});
+    if (!transition.oneWay) {
+      auto endToTransition = area.empty() ? area : area.join(_zones[endZone].zone.volume.commonRegion(area));
+      _transitions.add(endZone, {startZone, transition.movement, endToTransition});
+    }
   }
 
-  std::map<Zone, std::vector<Transition>> _transitions;
+  //the navigation file a loaded map reads its tables from
+  std::shared_ptr<utils::file::MappedFile const> _file {};
+  Adjacency<Transition> _transitions {};
   std::vector<NamedZone> _zones;
-  std::map<Zone, std::vector<Position>> _watchPoints;
+  ZoneIndex _zoneIndex {};
+  std::vector<NavigationGrid> _navigationGrids {};
+  std::array<ZoneId, zoneNameCount> _idsByName {};
+  //row major zone x zone tables, indexed by start then target
+  BakedArray<ZoneId> _nextHops {};
+  BakedArray<float> _routeCosts {};
+  //indexed by target then zone
+  std::vector<FlowField> _flowFields {};
+  BakedArray<Portal> _portals {};
+  //portals of zone z are [_portalOffsets[z], _portalOffsets[z + 1])
+  BakedArray<uint32> _portalOffsets {};
+  std::vector<FlowField> _portalFields {};
+  Adjacency<PortalStep> _portalSteps {};
+  Adjacency<Position> _watchPoints {};
+  //cells of zone z are numbered from _firstCells[z] in the sightline rows
+  std::vector<uint32> _firstCells {};
+  Adjacency<Sightline> _sightlines {};
 };
 
 } // namespace gabe
@@ -0,0 +1,191 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Exceptions.hpp"
+#include "Map.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace gabe {
+namespace impl {
+inline auto parseZoneName(std::string const& token) -> std::optional<Map::ZoneName> {
+  for (Size idx = 1; idx < Map::zoneNameCount; ++idx) {
+    Map::NamedZone const zone {{}, static_cast<Map::ZoneName>(idx)};
+    if (zone.toString() == token) {
+      return zone.name;
+    }
+  }
+  return std::nullopt;
+}
+
+inline auto parseMovement(std::string const& token) -> std::optional<Map::RequiredMovement> {
+  using enum Map::RequiredMovement;
+  static constexpr std::array<std::pair<std::string_view, Map::RequiredMovement>, 4> movements {
+      {{"NONE", NONE}, {"JUMP", JUMP}, {"JUMP_AND_CROUCH", JUMP_AND_CROUCH}, {"RUN_AND_JUMP", RUN_AND_JUMP}}};
+  auto const movement = std::ranges::find(movements, token, [](auto const& entry) { return entry.first; });
+  return movement == movements.end() ? std::nullopt : std::optional {movement->second};
+}
+
+class RecordParser {
+public:
+  RecordParser(std::string const& line, Size lineNumber, Map::Description& description) :
+      _record {line}, _lineNumber {lineNumber}, _description {description} {}
+
+  auto word() -> std::string {
+    std::string rez {};
+    if (!(_record >> rez)) {
+      fail("record ended early");
+    }
+    return rez;
+  }
+
+  auto zone() -> Map::ZoneName {
+    auto const token = word();
+    auto const name = parseZoneName(token);
+    if (!name) {
+      fail("unknown zone " + token);
+    }
+    return *name;
+  }
+
+  //a zone declared before this record
+  auto declaredZone() -> Map::NamedZone& {
+    auto const name = zone();
+    auto const zone = std::ranges::find(_description.zones, name, &Map::NamedZone::name);
+    if (zone == _description.zones.end()) {
+      fail("zone used before it is declared");
+    }
+    return *zone;
+  }
+
+  auto movement() -> Map::RequiredMovement {
+    auto const token = word();
+    auto const movement = parseMovement(token);
+    if (!movement) {
+      fail("unknown movement " + token);
+    }
+    return *movement;
+  }
+
+  auto number() -> float {
+    auto rez = 0.0f;
+    if (!(_record >> rez)) {
+      fail("expected a number");
+    }
+    return rez;
+  }
+
+  auto position() -> Position {
+    Position rez {};
+    if (!(_record >> rez.x >> rez.y >> rez.z)) {
+      fail("expected a position");
+    }
+    return rez;
+  }
+
+  auto volume() -> Volume {
+    auto const firstCorner = position();
+    return {firstCorner, position()};
+  }
+
+  [[nodiscard]] auto nextIsWord() -> bool {
+    _record >> std::ws;
+    return std::isalpha(_record.peek()) != 0;
+  }
+
+  [[nodiscard]] auto comment() -> bool {
+    _record >> std::ws;
+    return _record.peek() == '#';
+  }
+
+  [[nodiscard]] auto done() -> bool {
+    _record >> std::ws;
+    return _record.eof();
+  }
+
+  auto finish() -> void {
+    if (!done()) {
+      fail("unexpected text at the end of the record");
+    }
+  }
+
+  [[noreturn]] auto fail(std::string const& reason) const -> void {
+    throw exceptions::InvalidMapDescriptionException {_lineNumber, reason};
+  }
+
+private:
+  std::istringstream _record;
+  Size _lineNumber;
+  Map::Description& _description;
+};
+} // namespace impl
+
+//Reads a map description from its text form, one record per line; blank lines and lines starting with # are left
+//out. See data/maps/de_dust2.txt for the records
+inline auto parseMapDescription(std::string_view text) noexcept(false) -> Map::Description {
+  Map::Description rez {};
+  Size lineNumber {0};
+  while (!text.empty()) {
+    auto const lineEnd = std::min(text.find('\n'), text.size());
+    std::string const line {text.substr(0, lineEnd)};
+    text.remove_prefix(std::min(lineEnd + 1, text.size()));
+    ++lineNumber;
+
+    impl::RecordParser parser {line, lineNumber, rez};
+    if (parser.done() || parser.comment()) {
+      continue;
+    }
+    auto const kind = parser.word();
+    if (kind == "zone") {
+      auto const name = parser.zone();
+      if (std::ranges::find(rez.zones, name, &Map::NamedZone::name) != rez.zones.end()) {
+        parser.fail("zone declared twice");
+      }
+      rez.zones.push_back({Zone {parser.volume()}, name});
+    } else if (kind == "obstacle") {
+      auto& zone = parser.declaredZone().zone;
+      zone.obstacles.push_back(parser.volume());
+    } else if (kind == "hiding") {
+      auto& zone = parser.declaredZone().zone;
+      zone.hidingSpots.push_back(parser.volume());
+    } else if (kind == "transition") {
+      auto const start = parser.declaredZone().name;
+      Map::Description::Transition transition {start, parser.declaredZone().name};
+      if (!parser.done()) {
+        transition.movement = parser.movement();
+        auto const direction = parser.word();
+        if (direction != "oneway" && direction != "twoway") {
+          parser.fail("expected oneway or twoway");
+        }
+        transition.oneWay = direction == "oneway";
+        if (!parser.done()) {
+          transition.area = parser.volume();
+        }
+      }
+      rez.transitions.push_back(transition);
+    } else if (kind == "watchpoint") {
+      auto const zone = parser.declaredZone().name;
+      //either a position or a zone, standing for its center
+      auto const target = parser.nextIsWord() ? parser.declaredZone().zone.volume.center() : parser.position();
+      auto const priority = parser.done() ? 1.0f : parser.number();
+      if (priority < 0.0f) {
+        parser.fail("priorities must not be negative");
+      }
+      rez.watchpoints.push_back({zone, target, priority});
+    } else {
+      parser.fail("unknown record " + kind);
+    }
+    parser.finish();
+  }
+  return rez;
+}
+} // namespace gabe
@@ -4,117 +4,90 @@
 
 #pragma once
 
+#include "GridSearch.hpp"
+#include "IncrementalSearch.hpp"
 #include <algorithm>
-#include <queue>
+#include <optional>
 
 namespace gabe {
 
 template <typename Policy> struct MovementPolicy {
-  using SubZone = Zone::SubZone;
+  [[nodiscard]] auto getNextPoint(Position const& startPoint, Map::ZoneId startZone,
+                                  std::vector<Map::ZoneId> const& path) -> Position {
+    return static_cast<Policy*>(this)->getPoint(startPoint, startZone, path);
+  }
 
-  [[nodiscard]] auto getNextPoints(Position const& startPoint, Zone const& startZone,
-                                   std::vector<Zone> const& path) const -> std::vector<Position> {
-    return static_cast<Policy const*>(this)->getPoints(startPoint, startZone, path);
+  //fills transitionAreas, reusing its storage between calls
+  auto findTransitionAreas(Map::ZoneId start, Map::ZoneId target) -> void {
+    map.transitionAreas(start, target, transitionAreas);
   }
 
-  [[nodiscard]] auto findTransitionZone(Zone const& start, Zone const& target) const -> std::vector<Zone> {
-    auto transitions = map.possibleTransitions(start, target);
-    std::vector<Zone> result {};
-    for (auto const& t : transitions) {
-      if (!t.transitionArea.empty()) {
-        result.emplace_back(t.transitionArea);
+  //once inside an area leading to the target zone, head straight into it
+  [[nodiscard]] auto crossingPoint(Position const& startPoint, Map::ZoneId targetZone) const
+      -> std::optional<Position> {
+    for (auto const& transition : transitionAreas) {
+      if (transition.containsInXY(startPoint)) {
+        return map.zone(targetZone).zone.volume.closestPoint(startPoint);
       }
     }
-    if (result.empty()) {
-      result.emplace_back(start.volume.commonRegion(target.volume));
-    }
-    return result;
+    return std::nullopt;
   }
 
   Map const& map;
+  std::vector<Volume> transitionAreas {};
 };
 
-struct DirectMovementPolicy : public MovementPolicy<DirectMovementPolicy> {
-  [[nodiscard]] auto getPoints(Position const& startPoint, Zone const& startZone, std::vector<Zone> const& path) const
-      -> std::vector<Position> {
-    auto targetZone = path.back();
-    auto targetSubzones = targetZone.subzones();
-    auto transitionAreas = findTransitionZone(startZone, targetZone);
-    auto currentSubzones = startZone.subzones();
-    std::pair<int, int> indices {0, 0};
-
-    auto currentZone = currentSubzones[0][0];
-    for (auto lIdx = 0; lIdx < currentSubzones.size(); ++lIdx) {
-      for (auto cIdx = 0; cIdx < currentSubzones[0].size(); ++cIdx) {
-        if (currentSubzones[lIdx][cIdx].volume.distance(startPoint) < currentZone.volume.distance(startPoint)) {
-          indices = {lIdx, cIdx};
-          currentZone = currentSubzones[lIdx][cIdx];
-        }
-      }
+//reads the next point from the map's flow field into the next zone of the path; no search happens per call
+struct FlowFieldMovementPolicy : public MovementPolicy<FlowFieldMovementPolicy> {
+  [[nodiscard]] auto getPoint(Position const& startPoint, Map::ZoneId startZone,
+                              std::vector<Map::ZoneId> const& path) -> Position {
+    auto const target = path.back();
+    auto const next = map.nextHop(startZone, target);
+    if (startZone == target || next == Map::noZone) {
+      return startPoint;
     }
-
-    for (auto const& transition : transitionAreas) {
-      if (transition.volume.containsInXY(startPoint)) {
-        std::vector<Position> result;
-        result.push_back(targetZone.volume.closestPoint(startPoint));
-        return result;
-      }
+    findTransitionAreas(startZone, next);
+    if (auto crossing = crossingPoint(startPoint, next)) {
+      return *crossing;
     }
-
-    return astar(currentSubzones, transitionAreas, indices);
+    return map.flowField(next, startZone).waypoint(map.navigationGrid(startZone).closestCell(startPoint));
   }
+};
 
-  [[nodiscard]] auto astar(std::vector<std::vector<SubZone>> const& subzones, std::vector<Zone> const& transitionAreas,
-                           std::pair<int, int> const& startIndices) const -> std::vector<Position> {
-
-    std::array<std::pair<int, int>, 4> neighbours {std::pair<int, int> {-1, 0}, std::pair<int, int> {0, 1},
-                                                   std::pair<int, int> {1, 0}, std::pair<int, int> {0, -1}};
-    std::map<SubZone, SubZone> parents {};
-    std::map<SubZone, float> costs {};
-    auto comparator = [&costs](SubZone const& z1, SubZone const& z2) { return costs.at(z1) > costs.at(z2); };
-    std::priority_queue<SubZone, std::vector<SubZone>, decltype(comparator)> queue {comparator};
-
-    auto startZone = subzones[startIndices.first][startIndices.second];
-    costs[startZone] = 0;
-    parents[startZone] = startZone;
-    queue.push(startZone);
-
-    while (!queue.empty()) {
-      auto zone = queue.top();
-      queue.pop();
-      for (auto const& transition : transitionAreas) {
-        if (transition.volume.intersects(zone.volume)) {
-          std::vector<Position> result {};
-          result.push_back(transition.volume.center());
-          while (zone != startZone) {
-            result.push_back(zone.volume.center());
-            zone = parents[zone];
-          }
-          return result;
-        }
-      }
-      for (auto const& neighbour : neighbours) {
-        auto [line, column] =
-            std::pair<int, int> {neighbour.first + zone.indices.first, neighbour.second + zone.indices.second};
-        if (line >= 0 && line < subzones.size() && column >= 0 && column < subzones[0].size()) {
-          auto newZone = subzones[line][column];
-          if (!parents.contains(newZone) || costs[newZone] > costs[zone] + heuristic(newZone) + 1) {
-            costs[newZone] = costs[zone] + heuristic(newZone) + 1;
-            queue.push(newZone);
-            parents[newZone] = zone;
-          }
-        }
-      }
+//keeps its search between calls while the bot stays in the same zone heading for the same neighbour, repairing it
+//as the start moves; any other change starts a new search
+struct IncrementalMovementPolicy : public MovementPolicy<IncrementalMovementPolicy> {
+  [[nodiscard]] auto getPoint(Position const& startPoint, Map::ZoneId startZone,
+                              std::vector<Map::ZoneId> const& path) -> Position {
+    auto const targetZone = path.back();
+    findTransitionAreas(startZone, targetZone);
+    if (auto crossing = crossingPoint(startPoint, targetZone)) {
+      return *crossing;
     }
-    return {};
-  }
 
-  [[nodiscard]] auto heuristic(SubZone const& subzone) const -> float {
-    if (subzone.accessible) {
-      return 0;
+    if (startZone != plannedZone || targetZone != plannedTarget) {
+      planner.reset(map.navigationGrid(startZone), transitionAreas);
+      plannedZone = startZone;
+      plannedTarget = targetZone;
+    }
+    auto const& grid = planner.grid();
+    auto const startCell = grid.closestCell(startPoint);
+    if (!planner.plan(startCell)) {
+      return startPoint;
     }
-    return 100;
+    if (auto const next = planner.next(startCell); next != IncrementalSearch::noCell) {
+      return grid.center(next);
+    }
+    auto const startVolume = grid.volume(startCell);
+    auto const transition = std::ranges::find_if(transitionAreas, [&startVolume](Volume const& transitionArea) {
+      return transitionArea.intersects(startVolume);
+    });
+    return transition == transitionAreas.end() ? startPoint : transition->center();
   }
+
+  IncrementalSearch planner {};
+  Map::ZoneId plannedZone {Map::noZone};
+  Map::ZoneId plannedTarget {Map::noZone};
 };
 
 } // namespace gabe
\ No newline at end of file
@@ -0,0 +1,119 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "BakedArray.hpp"
+#include "Exceptions.hpp"
+#include "types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace gabe::nav {
+//A navigation file is a header followed by values and arrays, each array being its item count and then its items.
+//Everything starts at a multiple of alignment bytes from the start of the file, so arrays of a mapped file are read in
+//place. Items are stored as laid out in memory; the header records the layout the file was written with and readers
+//reject files of other versions or layouts
+static constexpr std::array<char, 8> magic {'G', 'A', 'B', 'E', 'N', 'A', 'V', '\0'};
+static constexpr uint32 version = 3;
+static constexpr Size alignment = 8;
+
+struct Header {
+  std::array<char, 8> magic;
+  uint32 version;
+  //changes with the byte order and the size of the words of the writer
+  uint32 layout;
+};
+
+static constexpr uint32 layout = 0x01020300u | static_cast<uint32>(sizeof(Size) + sizeof(float));
+
+template <typename T>
+concept Storable = std::is_trivially_copyable_v<T> && alignof(T) <= alignment;
+
+class Writer {
+public:
+  Writer() = delete;
+  Writer(Writer const&) = delete;
+  Writer(Writer&&) noexcept = delete;
+
+  explicit Writer(std::string const& filePath) : _out {filePath, std::ios::binary} {
+    value(Header {magic, version, layout});
+  }
+
+  template <Storable T> auto value(T const& item) -> void { write(&item, sizeof(T)); }
+
+  template <Storable T> auto array(std::span<T const> items) -> void {
+    value(static_cast<uint64>(items.size()));
+    write(items.data(), items.size_bytes());
+  }
+
+  template <Storable T> auto array(BakedArray<T> const& items) -> void { array(items.items()); }
+
+  //false when the file could not be opened or some write failed
+  [[nodiscard]] auto good() const -> bool { return _out.good(); }
+
+private:
+  auto write(void const* data, Size size) -> void {
+    _out.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+    std::array<char, alignment> const padding {};
+    _out.write(padding.data(), static_cast<std::streamsize>((alignment - size % alignment) % alignment));
+  }
+
+  std::ofstream _out;
+};
+
+//reads what a Writer wrote, in the same order; arrays borrow the bytes, which must outlive them
+class Reader {
+public:
+  Reader() = delete;
+  Reader(Reader const&) = delete;
+  Reader(Reader&&) noexcept = delete;
+
+  Reader(std::span<std::byte const> bytes, std::string const& filePath) : _bytes {bytes}, _filePath {filePath} {
+    auto const header = value<Header>();
+    expect(header.magic == magic && header.version == version && header.layout == layout);
+  }
+
+  template <Storable T> auto value() -> T {
+    T rez;
+    std::memcpy(&rez, take(sizeof(T)).data(), sizeof(T));
+    return rez;
+  }
+
+  template <Storable T> auto array() -> BakedArray<T> {
+    auto const count = value<uint64>();
+    expect(count <= _bytes.size() / sizeof(T));
+    auto const bytes = take(count * sizeof(T));
+    return BakedArray<T>::borrow({reinterpret_cast<T const*>(bytes.data()), count});
+  }
+
+  //rejects the file when what was read from it does not hold together
+  auto expect(bool condition) const -> void {
+    if (!condition) {
+      throw exceptions::InvalidNavFileException {_filePath};
+    }
+  }
+
+  //fails unless every byte was read
+  auto finish() const -> void { expect(_offset == _bytes.size()); }
+
+private:
+  auto take(Size size) -> std::span<std::byte const> {
+    auto const padded = size + (alignment - size % alignment) % alignment;
+    expect(padded <= _bytes.size() - _offset);
+    auto const rez = _bytes.subspan(_offset, size);
+    _offset += padded;
+    return rez;
+  }
+
+  std::span<std::byte const> _bytes;
+  std::string _filePath;
+  Size _offset {0};
+};
+} // namespace gabe::nav
@@ -0,0 +1,149 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "BakedArray.hpp"
+#include "NavFile.hpp"
+#include "types.hpp"
+#include "utils/math/geometry/Geometry.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace gabe {
+//Occupancy grid of a zone in cellSize x cellSize columns spanning the zone's height, baked when the map is compiled.
+//Cells are numbered line major, lines running along x and columns along y, and a cell is inaccessible when it
+//intersects any of the zone's obstacles; accessibility is kept as a bitset
+class NavigationGrid {
+public:
+  using Cell = uint32;
+
+  static constexpr float cellSize = 10.0f;
+  //added to the length of a step onto an inaccessible cell, so that routes only cross obstacles when they must
+  static constexpr float blockedPenalty = 100.0f;
+
+  NavigationGrid() = default;
+  NavigationGrid(NavigationGrid const&) = default;
+  NavigationGrid(NavigationGrid&&) noexcept = default;
+
+  NavigationGrid(Volume const& volume, std::span<Volume const> obstacles) :
+      _lowerCorner {std::min(volume.firstCorner.x, volume.secondCorner.x),
+                    std::min(volume.firstCorner.y, volume.secondCorner.y),
+                    std::min(volume.firstCorner.z, volume.secondCorner.z)},
+      _upperCorner {std::max(volume.firstCorner.x, volume.secondCorner.x),
+                    std::max(volume.firstCorner.y, volume.secondCorner.y),
+                    std::max(volume.firstCorner.z, volume.secondCorner.z)},
+      _lines {cellsAlong(_lowerCorner.x, _upperCorner.x)},
+      _columns {cellsAlong(_lowerCorner.y, _upperCorner.y)},
+      _accessible {std::vector<uint64>((size() + wordBits - 1) / wordBits, 0)} {
+    for (Cell cell = 0; cell < size(); ++cell) {
+      auto const cellVolume = this->volume(cell);
+      setAccessible(cell, std::ranges::none_of(obstacles, [&cellVolume](Volume const& ob) {
+                      return cellVolume.intersects(ob);
+                    }));
+    }
+  }
+
+  auto operator=(NavigationGrid const&) -> NavigationGrid& = default;
+  auto operator=(NavigationGrid&&) noexcept -> NavigationGrid& = default;
+
+  [[nodiscard]] auto lines() const -> Size { return _lines; }
+  [[nodiscard]] auto columns() const -> Size { return _columns; }
+  [[nodiscard]] auto size() const -> Size { return _lines * _columns; }
+
+  [[nodiscard]] auto cell(Size line, Size column) const -> Cell { return static_cast<Cell>(line * _columns + column); }
+  [[nodiscard]] auto line(Cell cell) const -> Size { return cell / _columns; }
+  [[nodiscard]] auto column(Cell cell) const -> Size { return cell % _columns; }
+
+  [[nodiscard]] auto accessible(Cell cell) const -> bool {
+    return (_accessible[cell / wordBits] >> (cell % wordBits) & 1u) != 0;
+  }
+
+  [[nodiscard]] auto penalty(Cell cell) const -> float { return accessible(cell) ? 0.0f : blockedPenalty; }
+
+  //calls visit(neighbour, length) for the 8 surrounding cells, leaving out diagonal steps which would cut the corner
+  //of an inaccessible cell; steps are symmetric, so these are the cells stepping onto this one as well
+  template <typename Visitor> auto forEachStep(Cell cell, Visitor&& visit) const -> void {
+    auto const line = static_cast<long>(this->line(cell));
+    auto const column = static_cast<long>(this->column(cell));
+    for (long lineStep = -1; lineStep <= 1; ++lineStep) {
+      for (long columnStep = -1; columnStep <= 1; ++columnStep) {
+        auto const nextLine = line + lineStep;
+        auto const nextColumn = column + columnStep;
+        if ((lineStep == 0 && columnStep == 0) || nextLine < 0 || nextColumn < 0
+            || nextLine >= static_cast<long>(_lines) || nextColumn >= static_cast<long>(_columns)) {
+          continue;
+        }
+        auto const diagonal = lineStep != 0 && columnStep != 0;
+        if (diagonal && (!accessible(this->cell(line, nextColumn)) || !accessible(this->cell(nextLine, column)))) {
+          continue;
+        }
+        visit(this->cell(nextLine, nextColumn), diagonal ? std::numbers::sqrt2_v<float> : 1.0f);
+      }
+    }
+  }
+
+  auto setAccessible(Cell cell, bool accessible) -> void {
+    auto& word = _accessible.mutableItems()[cell / wordBits];
+    if (accessible) {
+      word |= 1ull << (cell % wordBits);
+    } else {
+      word &= ~(1ull << (cell % wordBits));
+    }
+  }
+
+  [[nodiscard]] auto volume(Cell cell) const -> Volume {
+    auto const x = _lowerCorner.x + static_cast<float>(line(cell)) * cellSize;
+    auto const y = _lowerCorner.y + static_cast<float>(column(cell)) * cellSize;
+    return {{x, y, _lowerCorner.z},
+            {std::min(x + cellSize, _upperCorner.x), std::min(y + cellSize, _upperCorner.y), _upperCorner.z}};
+  }
+
+  [[nodiscard]] auto center(Cell cell) const -> Position { return volume(cell).center(); }
+
+  //the cell closest to the position; positions outside the zone snap to its border
+  [[nodiscard]] auto closestCell(Position const& position) const -> Cell {
+    auto clampedIndex = [](float value, float lower, Size count) {
+      auto const index = std::floor((value - lower) / cellSize);
+      return static_cast<Size>(std::clamp(index, 0.0f, static_cast<float>(count - 1)));
+    };
+    return cell(clampedIndex(position.x, _lowerCorner.x, _lines), clampedIndex(position.y, _lowerCorner.y, _columns));
+  }
+
+  auto write(nav::Writer& writer) const -> void {
+    writer.value(_lowerCorner);
+    writer.value(_upperCorner);
+    writer.value(_lines);
+    writer.value(_columns);
+    writer.array(_accessible);
+  }
+
+  static auto read(nav::Reader& reader) -> NavigationGrid {
+    NavigationGrid rez {};
+    rez._lowerCorner = reader.value<Position>();
+    rez._upperCorner = reader.value<Position>();
+    rez._lines = reader.value<Size>();
+    rez._columns = reader.value<Size>();
+    rez._accessible = reader.array<uint64>();
+    reader.expect(rez.size() > 0 && rez._accessible.size() == (rez.size() + wordBits - 1) / wordBits);
+    return rez;
+  }
+
+private:
+  static constexpr Size wordBits = 64;
+
+  static auto cellsAlong(float lower, float upper) -> Size {
+    return std::max<Size>(1, static_cast<Size>(std::ceil((upper - lower) / cellSize)));
+  }
+
+  Position _lowerCorner {};
+  Position _upperCorner {};
+  Size _lines {};
+  Size _columns {};
+  BakedArray<uint64> _accessible {};
+};
+} // namespace gabe
@@ -5,52 +5,108 @@
 #pragma once
 
 #include "Map.hpp"
-#include <queue>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
 
 namespace gabe {
 
 template <typename Policy> struct PathFindingPolicy {
-  auto computePath(Map::ZoneName startZone, Map::ZoneName targetZone) -> void {
-    static_cast<Policy*>(this)->getPath(startZone, targetZone);
+  auto computePath(Position const& start, Map::ZoneName targetZone) -> void {
+    static_cast<Policy*>(this)->getPath(start, targetZone);
   }
   Map const& map;
-  std::vector<Zone> path;
+  std::vector<Map::ZoneId> path {};
 };
 
 struct ShortestPathPolicy : public PathFindingPolicy<ShortestPathPolicy> {
+  auto getPath(Position const& start, Map::ZoneName targetZone) -> void {
+    getPath(map.zone(map.findZoneId(start)).name, targetZone);
+  }
+
+  //walks the map's routing table; the path is stored from the target back to the zone after the start
   auto getPath(Map::ZoneName startZone, Map::ZoneName targetZone) -> void {
     path.clear();
 
-    auto startMapZone = map.getZoneByName(startZone);
-    auto targetMapZone = map.getZoneByName(targetZone);
+    auto const start = map.zoneId(startZone);
+    auto const target = map.zoneId(targetZone);
+    if (start == Map::noZone || target == Map::noZone) {
+      return;
+    }
+    if (start == target) {
+      path.push_back(start);
+      return;
+    }
+
+    for (auto zone = map.nextHop(start, target); zone != Map::noZone; zone = map.nextHop(zone, target)) {
+      path.push_back(zone);
+      if (zone == target) {
+        break;
+      }
+    }
+    std::ranges::reverse(path);
+  }
+};
+//HPA* style: the route is searched over the map's portals, whose costs were measured on the navigation grids, and
+//only the way from the start to the portals of its zone depends on the query. Routes are the shortest walk rather
+//than the fewest zones
+struct HierarchicalPathPolicy : public PathFindingPolicy<HierarchicalPathPolicy> {
+  auto getPath(Position const& start, Map::ZoneName targetZone) -> void {
+    path.clear();
+    cost = std::numeric_limits<float>::infinity();
 
-    if (startZone == targetZone) {
-      path.push_back(startMapZone.zone);
+    auto const startZone = map.findZoneId(start);
+    auto const target = map.zoneId(targetZone);
+    if (target == Map::noZone) {
       return;
     }
+    if (startZone == target) {
+      path.push_back(target);
+      cost = 0.0f;
+      return;
+    }
+
+    costs.assign(map.portalCount(), std::numeric_limits<float>::infinity());
+    parents.assign(map.portalCount(), Map::noPortal);
+    queue.clear();
+    auto open = [this](Map::PortalId portal, Map::PortalId parent, float portalCost) {
+      if (portalCost < costs[portal]) {
+        costs[portal] = portalCost;
+        parents[portal] = parent;
+        queue.emplace_back(portalCost, portal);
+        std::ranges::push_heap(queue, std::greater {});
+      }
+    };
 
-    std::map<Zone, Zone> parents {};
-    std::queue<Zone> zoneQueue {};
-    zoneQueue.push(startMapZone.zone);
-    parents[startMapZone.zone] = startMapZone.zone;
-    while (!zoneQueue.empty()) {
-      auto currZone = zoneQueue.front();
-      zoneQueue.pop();
-      for (auto const& zone : map.transitions().at(currZone)) {
-        if (!parents.contains(zone.zone)) {
-          if (zone.zone == targetMapZone.zone) {
-            path.push_back(map.getZoneByName(targetZone).zone);
-            while (currZone != startMapZone.zone) {
-              path.push_back(map.getZoneByVolume(currZone).zone);
-              currZone = parents[currZone];
-            }
-            return;
-          }
-          parents[zone.zone] = currZone;
-          zoneQueue.push(zone.zone);
+    auto const startCell = map.navigationGrid(startZone).closestCell(start);
+    for (auto const& portal : map.portals(startZone)) {
+      open(portal.id, Map::noPortal, map.portalField(portal.id).distance(startCell));
+    }
+    while (!queue.empty()) {
+      std::ranges::pop_heap(queue, std::greater {});
+      auto const [portalCost, portal] = queue.back();
+      queue.pop_back();
+      if (portalCost > costs[portal]) {
+        continue;
+      }
+      if (map.portal(portal).to == target) {
+        cost = portalCost;
+        for (auto step = portal; step != Map::noPortal; step = parents[step]) {
+          path.push_back(map.portal(step).to);
         }
+        return;
+      }
+      for (auto const& step : map.portalSteps(portal)) {
+        open(step.portal, portal, portalCost + step.cost);
       }
     }
   }
+
+  //of the last path found, in navigation cells
+  float cost {std::numeric_limits<float>::infinity()};
+  std::vector<float> costs {};
+  std::vector<Map::PortalId> parents {};
+  std::vector<std::pair<float, Map::PortalId>> queue {};
 };
 } // namespace gabe
@@ -0,0 +1,151 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "DecisionTree.hpp"
+#include "GameState.hpp"
+#include "utils/random/AliasTable.hpp"
+#include "utils/random/Random.hpp"
+#include <array>
+#include <cassert>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace gabe {
+//weight update policies of a static node, chosen by tag
+struct FixedWeights {};
+
+//switches between Weights::regular and Weights::planted with the bomb state
+template <typename Weights> struct BombStateWeights {};
+
+template <typename Tag, Size childCount> struct WeightPolicy;
+
+template <Size childCount> struct WeightPolicy<FixedWeights, childCount> {
+  static auto update(GameState const&, std::array<float, childCount>&) -> bool { return false; }
+};
+
+template <typename Weights, Size childCount> struct WeightPolicy<BombStateWeights<Weights>, childCount> {
+  static_assert(Weights::regular.size() == childCount && Weights::planted.size() == childCount,
+                "Weight sets must cover every child");
+
+  static auto update(GameState const& state, std::array<float, childCount>& weights) -> bool {
+    auto const& target =
+        state.round().bombState() == Round::BombState::PLANTED ? Weights::planted : Weights::regular;
+    if (weights == target) {
+      return false;
+    }
+    weights = target;
+    return true;
+  }
+};
+
+//a decision tree whose shape is part of its type: Tree supplies the node's own behaviour and the children live in a
+//tuple, so every call below the root is bound at compile time. Tree is built from treeArgs, whose first element is
+//the game state; only its enter, act and postEvaluation are used and its runtime children stay empty
+template <typename Tree, typename WeightTag, typename... Children> class StaticNode {
+public:
+  static constexpr Size childCount = sizeof...(Children);
+
+  StaticNode() = delete;
+  StaticNode(StaticNode const&) = delete;
+  StaticNode(StaticNode&&) noexcept = default;
+
+  template <typename... TreeArgs>
+  StaticNode(std::tuple<TreeArgs...>&& treeArgs, std::array<float, childCount> const& weights,
+             Children&&... children) :
+      _state {std::get<0>(treeArgs)}, _tree {std::make_from_tuple<Tree>(std::move(treeArgs))},
+      _children {std::move(children)...},
+      _weights {weights} {
+    assert(std::accumulate(_weights.begin(), _weights.end(), .0f) <= 1.0f && "Child weights exceed 1");
+  }
+
+  auto evaluate() -> AnyEvent {
+    if (!_tree.Tree::enter()) {
+      return EmptyEvent {};
+    }
+    if constexpr (childCount == 0) {
+      return _tree.Tree::act();
+    } else {
+      if (_weightsChanged) {
+        rebuildSelection();
+      }
+      return evaluateChild(_selection.sample(_generator));
+    }
+  }
+
+  auto postEvaluation() -> void {
+    _tree.Tree::postEvaluation();
+    std::apply([](auto&... child) { (child.postEvaluation(), ...); }, _children);
+    if (WeightPolicy<WeightTag, childCount>::update(_state, _weights)) {
+      _weightsChanged = true;
+    }
+  }
+
+  [[nodiscard]] auto access() const -> ResourceAccess {
+    return std::apply([this](auto const&... child) { return (_tree.Tree::ownAccess() | ... | child.access()); },
+                      _children);
+  }
+
+private:
+  //an index past the last child is the probability left over by the children and evaluates to nothing
+  template <Size idx = 0> auto evaluateChild(Size chosen) -> AnyEvent {
+    if constexpr (idx == childCount) {
+      return EmptyEvent {};
+    } else {
+      if (chosen == idx) {
+        return std::get<idx>(_children).evaluate();
+      }
+      return evaluateChild<idx + 1>(chosen);
+    }
+  }
+
+  auto rebuildSelection() -> void {
+    std::array<float, childCount + 1> weights {};
+    std::copy(_weights.begin(), _weights.end(), weights.begin());
+    weights.back() = std::max(1.0f - std::accumulate(_weights.begin(), _weights.end(), .0f), .0f);
+    _selection.rebuild(weights);
+    _weightsChanged = false;
+  }
+
+  GameState const& _state;
+  Tree _tree;
+  std::tuple<Children...> _children;
+  std::array<float, childCount> _weights;
+  utils::random::AliasTable _selection {};
+  utils::random::Xoshiro256 _generator {utils::random::nextStream()};
+  bool _weightsChanged {true};
+};
+
+template <typename Tree, typename WeightTag = FixedWeights, typename... TreeArgs, typename... Children>
+auto staticNode(std::tuple<TreeArgs...>&& treeArgs, std::array<float, sizeof...(Children)> const& weights,
+                Children&&... children) -> StaticNode<Tree, WeightTag, std::remove_cvref_t<Children>...> {
+  return {std::move(treeArgs), weights, std::forward<Children>(children)...};
+}
+
+template <typename Tree, typename... TreeArgs> auto staticLeaf(GameState& state, TreeArgs&&... treeArgs) {
+  return staticNode<Tree>(std::forward_as_tuple(state, std::forward<TreeArgs>(treeArgs)...), {});
+}
+
+//hands a static tree to code that schedules runtime trees; the root call is the only virtual one per tick
+template <typename Root> class StaticDecisionTree : public DecisionTree {
+public:
+  template <typename Factory>
+  StaticDecisionTree(GameState& state, Factory&& factory) : DecisionTree {state}, _root {factory()} {}
+
+  auto evaluate() -> AnyEvent override { return _root.evaluate(); }
+  auto postEvaluation() -> void override { _root.postEvaluation(); }
+  [[nodiscard]] auto ownAccess() const -> ResourceAccess override { return _root.access(); }
+
+private:
+  Root _root;
+};
+
+template <typename Factory> auto makeStaticTree(GameState& state, Factory&& factory) -> std::unique_ptr<DecisionTree> {
+  return std::make_unique<StaticDecisionTree<std::invoke_result_t<Factory>>>(state, std::forward<Factory>(factory));
+}
+} // namespace gabe
@@ -0,0 +1,229 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "BakedArray.hpp"
+#include "NavFile.hpp"
+#include "types.hpp"
+#include "utils/math/geometry/Geometry.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace gabe {
+//Uniform grid over the XY extent of a set of boxes answering which box is nearest to a point. Every cell keeps the
+//boxes that can be nearest to some point of the cell: those not further from the cell than the closest bound on the
+//distance to any box. Points inside the grid test only their cell's candidates, which are one or two boxes wherever
+//boxes cover the ground; points outside fall back to testing every box. Candidates are kept in box order so ties
+//are resolved towards the first box, as a linear scan would
+class ZoneIndex {
+public:
+  using ZoneId = uint16;
+
+  static constexpr float defaultCellSize = 64.0f;
+
+  ZoneIndex() = default;
+  ZoneIndex(ZoneIndex const&) = default;
+  ZoneIndex(ZoneIndex&&) noexcept = default;
+
+  explicit ZoneIndex(std::span<Volume const> volumes, float cellSize = defaultCellSize) : _cellSize {cellSize} {
+    assert(!volumes.empty() && volumes.size() <= std::numeric_limits<ZoneId>::max() && "Unsupported zone count");
+    std::vector<Box> boxes {};
+    std::vector<ZoneId> allZones {};
+    boxes.reserve(volumes.size());
+    for (auto const& volume : volumes) {
+      allZones.push_back(static_cast<ZoneId>(boxes.size()));
+      boxes.push_back(Box::of(volume));
+    }
+    _boxes = BakedArray {std::move(boxes)};
+    _allZones = BakedArray {std::move(allZones)};
+    buildGrid();
+  }
+
+  auto operator=(ZoneIndex const&) -> ZoneIndex& = default;
+  auto operator=(ZoneIndex&&) noexcept -> ZoneIndex& = default;
+
+  [[nodiscard]] auto nearest(Position const& position) const -> ZoneId {
+    auto const point = std::array {position.x, position.y, position.z};
+    if (!_bounds.contains(point)) {
+      return nearestOf(point, _allZones.items());
+    }
+    auto const column = std::min(static_cast<Size>((point[0] - _bounds.lo[0]) / _cellSize), _columns - 1);
+    auto const row = std::min(static_cast<Size>((point[1] - _bounds.lo[1]) / _cellSize), _rows - 1);
+    auto const cell = row * _columns + column;
+    auto const first = _cellOffsets[cell];
+    auto const candidates = _cellZones.items().subspan(first, _cellOffsets[cell + 1] - first);
+    return nearestOf(point, candidates);
+  }
+
+  [[nodiscard]] auto size() const -> Size { return _boxes.size(); }
+
+  auto write(nav::Writer& writer) const -> void {
+    writer.array(_boxes);
+    writer.value(_bounds);
+    writer.value(_cellSize);
+    writer.value(_columns);
+    writer.value(_rows);
+    writer.array(_cellOffsets);
+    writer.array(_cellZones);
+    writer.array(_allZones);
+  }
+
+  static auto read(nav::Reader& reader) -> ZoneIndex {
+    ZoneIndex rez {};
+    rez._boxes = reader.array<Box>();
+    rez._bounds = reader.value<Box>();
+    rez._cellSize = reader.value<float>();
+    reader.expect(std::isfinite(rez._cellSize) && rez._cellSize > 0.0f && rez._bounds.valid());
+    rez._columns = reader.value<Size>();
+    rez._rows = reader.value<Size>();
+    reader.expect(static_cast<float>(rez._columns) == rez.cellsAlong(0)
+                  && static_cast<float>(rez._rows) == rez.cellsAlong(1));
+    rez._cellOffsets = reader.array<uint32>();
+    rez._cellZones = reader.array<ZoneId>();
+    rez._allZones = reader.array<ZoneId>();
+    reader.expect(!rez._boxes.empty() && rez._allZones.size() == rez._boxes.size()
+                  && rez._cellOffsets.size() == rez._columns * rez._rows + 1
+                  && std::ranges::is_sorted(rez._cellOffsets.items())
+                  && rez._cellOffsets[rez._cellOffsets.size() - 1] == rez._cellZones.size()
+                  && std::ranges::all_of(rez._cellZones.items(), [&rez](ZoneId id) { return id < rez.size(); }));
+    return rez;
+  }
+
+private:
+  using Point3 = std::array<float, 3>;
+
+  struct Box {
+    Point3 lo;
+    Point3 hi;
+
+    static auto of(Volume const& volume) -> Box {
+      auto const& first = volume.firstCorner;
+      auto const& second = volume.secondCorner;
+      return {{std::min(first.x, second.x), std::min(first.y, second.y), std::min(first.z, second.z)},
+              {std::max(first.x, second.x), std::max(first.y, second.y), std::max(first.z, second.z)}};
+    }
+
+    //finite, with no side of negative length
+    [[nodiscard]] auto valid() const -> bool {
+      for (Size axis = 0; axis < 3; ++axis) {
+        if (!std::isfinite(lo[axis]) || !std::isfinite(hi[axis]) || lo[axis] > hi[axis]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    [[nodiscard]] auto contains(Point3 const& point) const -> bool {
+      for (Size axis = 0; axis < 3; ++axis) {
+        if (point[axis] < lo[axis] || point[axis] > hi[axis]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    [[nodiscard]] auto squaredDistance(Point3 const& point) const -> float {
+      auto rez = 0.0f;
+      for (Size axis = 0; axis < 3; ++axis) {
+        auto const delta = point[axis] - std::clamp(point[axis], lo[axis], hi[axis]);
+        rez += delta * delta;
+      }
+      return rez;
+    }
+
+    [[nodiscard]] auto squaredDistance(Box const& other) const -> float {
+      auto rez = 0.0f;
+      for (Size axis = 0; axis < 3; ++axis) {
+        auto const gap = std::max({0.0f, other.lo[axis] - hi[axis], lo[axis] - other.hi[axis]});
+        rez += gap * gap;
+      }
+      return rez;
+    }
+
+    //the distance to a box is convex, so over another box it peaks at one of its corners
+    [[nodiscard]] auto squaredFarthestDistance(Box const& other) const -> float {
+      auto rez = 0.0f;
+      for (auto corner = 0u; corner < 8u; ++corner) {
+        Point3 const point {(corner & 1u) != 0 ? other.hi[0] : other.lo[0],
+                            (corner & 2u) != 0 ? other.hi[1] : other.lo[1],
+                            (corner & 4u) != 0 ? other.hi[2] : other.lo[2]};
+        rez = std::max(rez, squaredDistance(point));
+      }
+      return rez;
+    }
+  };
+
+  //grid cells covering the bounds along an axis
+  [[nodiscard]] auto cellsAlong(Size axis) const -> float {
+    return std::max(1.0f, std::ceil((_bounds.hi[axis] - _bounds.lo[axis]) / _cellSize));
+  }
+
+  auto buildGrid() -> void {
+    _bounds = _boxes[0];
+    for (auto const& box : _boxes.items()) {
+      for (Size axis = 0; axis < 3; ++axis) {
+        _bounds.lo[axis] = std::min(_bounds.lo[axis], box.lo[axis] - _cellSize);
+        _bounds.hi[axis] = std::max(_bounds.hi[axis], box.hi[axis] + _cellSize);
+      }
+    }
+    _columns = static_cast<Size>(cellsAlong(0));
+    _rows = static_cast<Size>(cellsAlong(1));
+
+    std::vector<uint32> cellOffsets(_columns * _rows + 1, 0);
+    std::vector<ZoneId> cellZones {};
+    for (Size row = 0; row < _rows; ++row) {
+      for (Size column = 0; column < _columns; ++column) {
+        Box const cell {{_bounds.lo[0] + static_cast<float>(column) * _cellSize,
+                         _bounds.lo[1] + static_cast<float>(row) * _cellSize, _bounds.lo[2]},
+                        {_bounds.lo[0] + static_cast<float>(column + 1) * _cellSize,
+                         _bounds.lo[1] + static_cast<float>(row + 1) * _cellSize, _bounds.hi[2]}};
+        auto bound = std::numeric_limits<float>::max();
+        for (auto const& box : _boxes.items()) {
+          bound = std::min(bound, box.squaredFarthestDistance(cell));
+        }
+        for (Size id = 0; id < _boxes.size(); ++id) {
+          if (_boxes[id].squaredDistance(cell) <= bound) {
+            cellZones.push_back(static_cast<ZoneId>(id));
+          }
+        }
+        cellOffsets[row * _columns + column + 1] = static_cast<uint32>(cellZones.size());
+      }
+    }
+    _cellOffsets = BakedArray {std::move(cellOffsets)};
+    _cellZones = BakedArray {std::move(cellZones)};
+  }
+
+  [[nodiscard]] auto nearestOf(Point3 const& point, std::span<ZoneId const> candidates) const -> ZoneId {
+    auto best = candidates.front();
+    auto bestDistance = std::numeric_limits<float>::max();
+    for (auto id : candidates) {
+      auto const distance = _boxes[id].squaredDistance(point);
+      if (distance < bestDistance) {
+        best = id;
+        bestDistance = distance;
+        if (distance == 0.0f) {
+          break;
+        }
+      }
+    }
+    return best;
+  }
+
+  BakedArray<Box> _boxes {};
+  Box _bounds {};
+  float _cellSize {defaultCellSize};
+  Size _columns {};
+  Size _rows {};
+  //cell c holds _cellZones[_cellOffsets[c], _cellOffsets[c + 1])
+  BakedArray<uint32> _cellOffsets {};
+  BakedArray<ZoneId> _cellZones {};
+  BakedArray<ZoneId> _allZones {};
+};
+} // namespace gabe
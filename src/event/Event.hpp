@@ -5,15 +5,23 @@
 #pragma once
 
 #include "../engine/Weapon.hpp"
-#include <X11/Xutil.h>
-#include <X11/extensions/XTest.h>
+#include "backend/InputBackend.hpp"
+#include <array>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <cstring>
 #include <jpeglib.h>
+#include <map>
+#include <multithreaded/frameRing/FrameRing.hpp>
+#include <replay/Recorder.hpp>
+#include <span>
 #include <types.hpp>
 #include <unistd.h>
 #include <utils/logger/Logger.hpp>
+#include <utils/trace/Trace.hpp>
+#include <variant>
+#include <vector>
 
 namespace gabe {
 static constexpr auto dpiScalingFactor = 1;
@@ -51,18 +59,9 @@ static auto saveImage(std::string_view filename, unsigned char* data, int width,
 }
 
 
-class Event {
-public:
-  virtual auto solve(Display* display, Window window) -> void = 0;
-  virtual ~Event() = default;
-  auto translateCoordinates(Display* display, Window window) -> Point {
-    int targetX;
-    int targetY;
-    Window child;
-    XTranslateCoordinates(display, window, DefaultRootWindow(display), 0, 0, &targetX, &targetY, &child);
-    return {targetX, targetY};
-  }
-};
+//events are plain values kept in AnyEvent and dispatched through std::visit, so solve is not virtual. Solving an event
+//sends its inputs to a backend as actions, with the waits between them attached as delays
+class Event {};
 
 class EmptyEvent : public Event {
 public:
@@ -70,7 +69,7 @@ public:
   EmptyEvent(EmptyEvent const&) = default;
   EmptyEvent(EmptyEvent&&) noexcept = default;
 
-  auto solve(Display* display, Window window) -> void override {
+  auto solve(InputBackend& backend) -> void {
     //empty on purpose
   }
 };
@@ -81,13 +80,7 @@ public:
   MouseScanEvent(MouseScanEvent const&) = default;
   MouseScanEvent(MouseScanEvent&&) noexcept = default;
 
-  auto solve(Display* display, Window window) -> void override {
-    Window childWindow;
-    int rootX, rootY, winX, winY;
-    unsigned int mask;
-
-    XQueryPointer(display, window, &window, &childWindow, &rootX, &rootY, &winX, &winY, &mask);
-  }
+  auto solve(InputBackend& backend) -> void { backend.pointer(); }
 };
 
 class MouseMoveEvent : public Event {
@@ -97,17 +90,10 @@ public:
   MouseMoveEvent(MouseMoveEvent&&) noexcept = default;
   explicit MouseMoveEvent(Point const& point) : _point {point} {}
 
-  auto solve(Display* display, Window window) -> void override {
+  auto solve(InputBackend& backend) -> void {
     _point *= dpiScalingFactor;
-
-    XSetInputFocus(display, window, RevertToParent, CurrentTime);
-    XFlush(display);
-
-    XSelectInput(display, window, PointerMotionMask);
-    XFlush(display);
-
-    XTestFakeMotionEvent(display, -1, _point.x, _point.y, CurrentTime);
-    XFlush(display);
+    backend.perform(Action::focus());
+    backend.perform(Action::motion(_point));
   }
 
 private:
@@ -122,31 +108,17 @@ public:
   StrafeEvent(Point const& movement, int iterationCount, int strafeSpeed) :
       _itCount {iterationCount}, _strafeSpeed {strafeSpeed}, _totalMovement {movement} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    XWindowAttributes attr;
-    int revert;
-    XGetInputFocus(display, &window, &revert);
-    XGetWindowAttributes(display, window, &attr);
-
-    XSelectInput(display, window, PointerMotionMask);
-    XFlush(display);
-
+  auto solve(InputBackend& backend) -> void {
     Point p {};
     for (auto idx = 0; idx < _itCount; ++idx) {
       p = _totalMovement / _itCount;
-      XSelectInput(display, window, PointerMotionMask);
-      XFlush(display);
-
-      XTestFakeMotionEvent(display, -1, p.x, p.y, CurrentTime);
-      XFlush(display);
-      usleep(_strafeSpeed);
+      backend.perform(Action::motion(p, Action::Delay {_strafeSpeed}));
     }
 
     _totalMovement = _totalMovement / _itCount * _itCount;
   }
 
 private:
-  static constexpr auto sleepTime = 5000;
   int _itCount {};
   int _strafeSpeed {};
   Point _totalMovement {};
@@ -160,9 +132,9 @@ public:
   FullStrafeEvent(Point const& movement, int large, int small, int sleep) :
       _totalMovement {movement}, _largeSteps {large}, _smallSteps {small}, _sleepTime {sleep} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    StrafeEvent(_totalMovement, _largeSteps, _sleepTime).solve(display, window);
-    StrafeEvent(_totalMovement % _largeSteps, _smallSteps, _sleepTime).solve(display, window);
+  auto solve(InputBackend& backend) -> void {
+    StrafeEvent(_totalMovement, _largeSteps, _sleepTime).solve(backend);
+    StrafeEvent(_totalMovement % _largeSteps, _smallSteps, _sleepTime).solve(backend);
   }
 
 private:
@@ -178,44 +150,28 @@ public:
   ScreenshotEvent(ScreenshotEvent const&) = default;
   ScreenshotEvent(ScreenshotEvent&&) noexcept = default;
 
-  explicit ScreenshotEvent(unsigned char* targetData) : _pTargetData(targetData) {}
-
-  auto solve(Display* display, Window window) -> void override {
-    XWindowAttributes attr;
-    XGetWindowAttributes(display, window, &attr);
-
-    XImage* img = XGetImage(display, window, 0, 0, attr.width, attr.height, AllPlanes, ZPixmap);
-    char const* data = img->data;
-    assert(attr.width == expectedScreenWidth && attr.height == expectedScreenHeight
-           && "Window does not match expected sizes");
-
-    int bytesPerPixel = img->bits_per_pixel / 8;
-    int bytesPerLine = img->bytes_per_line;
-    for (int y = 0; y < attr.height; ++y) {
-      for (int x = 0; x < attr.width; ++x) {
-        int offset = y * bytesPerLine + x * bytesPerPixel;
-        int jpgOffset = y * attr.width * 3 + x * 3;
+  //the capture must already be claimed with FrameRing::beginCapture; solving it publishes the frame
+  explicit ScreenshotEvent(FrameRing& frames) : _pFrames {&frames} {}
 
-        _pTargetData[jpgOffset + 0] = data[offset + 2];
-        _pTargetData[jpgOffset + 1] = data[offset + 1];
-        _pTargetData[jpgOffset + 2] = data[offset + 0];
-      }
+  auto solve(InputBackend& backend) -> void {
+    utils::trace::Span span {"screenshot", utils::trace::Stage::CAPTURE};
+    auto const captureTime = FrameRing::Clock::now();
+    auto* targetData = _pFrames->captureBuffer();
+    if (!backend.capture(targetData, _pFrames->frameSize())) {
+      _pFrames->cancelCapture();
+      return;
     }
-    XDestroyImage(img);
+    replay::record(replay::Source::FRAME, {reinterpret_cast<char const*>(targetData), _pFrames->frameSize()});
+    span.setFlow(_pFrames->publish(captureTime));
   }
 
 private:
-  unsigned char* _pTargetData;
+  FrameRing* _pFrames;
 };
 
 struct MouseButton {
-  enum class Button : int {
-    LEFT_BUTTON = Button1,
-    RIGHT_BUTTON = Button2,
-    WHEEL_PRESSED = Button3,
-    WHEEL_UP = Button4,
-    WHEEL_DOWN = Button5
-  };
+  //X button numbers
+  enum class Button : int { LEFT_BUTTON = 1, RIGHT_BUTTON = 2, WHEEL_PRESSED = 3, WHEEL_UP = 4, WHEEL_DOWN = 5 };
 
   MouseButton() = default;
   MouseButton(MouseButton const&) = default;
@@ -245,11 +201,9 @@ public:
   MouseActionEvent(MouseActionEvent&&) noexcept = default;
   MouseActionEvent(MouseButton::Button val, bool press) : _buttonType {val}, _press {press} {}
 
-  auto solve(Display* display, Window window) -> void override {
+  auto solve(InputBackend& backend) -> void {
     auto buttonId = static_cast<std::underlying_type_t<MouseButton::Button>>(_buttonType.button);
-    XTestFakeButtonEvent(display, buttonId, _press, CurrentTime);
-    XFlush(display);
-    usleep(sleepTime);
+    backend.perform(Action::button(buttonId, _press, Action::Delay {sleepTime}));
   }
 
 private:
@@ -265,9 +219,9 @@ public:
   MouseClickEvent(MouseClickEvent&&) noexcept = default;
   explicit MouseClickEvent(MouseButton::Button val) : _buttonType {val} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    MouseActionEvent(_buttonType.button, true).solve(display, window);
-    MouseActionEvent(_buttonType.button, false).solve(display, window);
+  auto solve(InputBackend& backend) -> void {
+    MouseActionEvent(_buttonType.button, true).solve(backend);
+    MouseActionEvent(_buttonType.button, false).solve(backend);
   }
 
 private:
@@ -281,10 +235,10 @@ public:
   MouseHoldEvent(MouseHoldEvent&&) noexcept = default;
   explicit MouseHoldEvent(MouseButton::Button val, int sts) : _buttonType {val}, _sleepTimeSeconds {sts} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    MouseActionEvent(_buttonType.button, true).solve(display, window);
-    sleep(_sleepTimeSeconds);
-    MouseActionEvent(_buttonType.button, false).solve(display, window);
+  auto solve(InputBackend& backend) -> void {
+    MouseActionEvent(_buttonType.button, true).solve(backend);
+    backend.perform(Action::wait(std::chrono::seconds {_sleepTimeSeconds}));
+    MouseActionEvent(_buttonType.button, false).solve(backend);
   }
 
 private:
@@ -301,20 +255,20 @@ public:
   ShootEvent(ShootEvent&&) noexcept = default;
   ShootEvent(Point const& movement, AimType aimType) : _totalMovement {movement}, _aimType {aimType} {}
 
-  auto solve(Display* display, Window window) -> void override {
+  auto solve(InputBackend& backend) -> void {
     switch (_aimType) {
       using enum AimType;
       case FLICK: {
         constexpr auto largeSteps = 50;
         constexpr auto smallSteps = 2;
-        FullStrafeEvent(_totalMovement, largeSteps, smallSteps, 2750).solve(display, window);
-        MouseClickEvent(MouseButton::Button::LEFT_BUTTON).solve(display, window);
+        FullStrafeEvent(_totalMovement, largeSteps, smallSteps, 2750).solve(backend);
+        MouseClickEvent(MouseButton::Button::LEFT_BUTTON).solve(backend);
         break;
       }
       case TAP: {
-        StrafeEvent(_totalMovement, 1, 250).solve(display, window);
-        MouseClickEvent(MouseButton::Button::LEFT_BUTTON).solve(display, window);
-        usleep(1500);
+        StrafeEvent(_totalMovement, 1, 250).solve(backend);
+        MouseClickEvent(MouseButton::Button::LEFT_BUTTON).solve(backend);
+        backend.perform(Action::wait(Action::Delay {1500}));
         break;
       }
     }
@@ -350,23 +304,23 @@ public:
   SprayEvent(Point const& startPoint, int bulletCount, Weapon const& weapon) :
       _startPoint {startPoint}, _bulletCount {bulletCount}, _weapon {weapon} {}
 
-  auto solve(Display* display, Window window) -> void override {
+  auto solve(InputBackend& backend) -> void {
 
-    StrafeEvent(_startPoint, 1, 250).solve(display, window);
+    StrafeEvent(_startPoint, 1, 250).solve(backend);
     if (_weapon.automatic) {
-      MouseActionEvent(MouseButton::Button::LEFT_BUTTON, true).solve(display, window);
+      MouseActionEvent(MouseButton::Button::LEFT_BUTTON, true).solve(backend);
       for (auto idx = 0; idx < _bulletCount; ++idx) {
-        StrafeEvent(_weapon.getSpray(), 1, 0).solve(display, window);
-        usleep(static_cast<int>(55000000 / _weapon.firerate));
+        StrafeEvent(_weapon.sprayPoint(idx), 1, 0).solve(backend);
+        backend.perform(Action::wait(Action::Delay {static_cast<int>(55000000 / _weapon.firerate)}));
       }
-      MouseActionEvent(MouseButton::Button::LEFT_BUTTON, false).solve(display, window);
+      MouseActionEvent(MouseButton::Button::LEFT_BUTTON, false).solve(backend);
     } else {
       if (_weapon == KNIFE) {
-        MouseClickEvent(MouseButton::Button::LEFT_BUTTON).solve(display, window);
+        MouseClickEvent(MouseButton::Button::LEFT_BUTTON).solve(backend);
       } else {
         for (auto idx = 0; idx < _bulletCount; ++idx) {
-          MouseClickEvent(MouseButton::Button::LEFT_BUTTON).solve(display, window);
-          usleep(static_cast<int>(60000000 / _weapon.firerate));
+          MouseClickEvent(MouseButton::Button::LEFT_BUTTON).solve(backend);
+          backend.perform(Action::wait(Action::Delay {static_cast<int>(60000000 / _weapon.firerate)}));
         }
       }
     }
@@ -386,30 +340,7 @@ public:
   KeyActionEvent(KeyActionEvent&&) noexcept = default;
   KeyActionEvent(char key, int sleepTime, bool press) : _key {key}, _sleepTime {sleepTime}, _press {press} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    KeySym keyCode {static_cast<KeySym>(_key)};
-    if (static_cast<int>(_key) >= 0x20) {
-      keyCode = XKeysymToKeycode(display, _key);
-    } else {
-      switch (_key) {
-        case '\n': {
-          keyCode = XKeysymToKeycode(display, XK_Return);
-          break;
-        }
-        case ' ': {
-          keyCode = XKeysymToKeycode(display, XK_space);
-          break;
-        }
-        case 27: {
-          keyCode = XKeysymToKeycode(display, XK_Escape);
-          break;
-        }
-      }
-    }
-    XTestFakeKeyEvent(display, keyCode, _press, CurrentTime);
-    XSync(display, False);
-    usleep(_sleepTime);
-  }
+  auto solve(InputBackend& backend) -> void { backend.perform(Action::key(_key, _press, Action::Delay {_sleepTime})); }
 
 private:
   char _key {};
@@ -424,9 +355,9 @@ public:
   KeyPressEvent(KeyPressEvent&&) noexcept = default;
   KeyPressEvent(char key, int sleepTime) : _key {key}, _sleepTime {sleepTime} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    KeyActionEvent(_key, _sleepTime / 2, true).solve(display, window);
-    KeyActionEvent(_key, _sleepTime / 2, false).solve(display, window);
+  auto solve(InputBackend& backend) -> void {
+    KeyActionEvent(_key, _sleepTime / 2, true).solve(backend);
+    KeyActionEvent(_key, _sleepTime / 2, false).solve(backend);
   }
 
 private:
@@ -443,24 +374,11 @@ public:
   KeyCombinationEvent(char key, int sleepTime, Modifiers modifier) :
       KeyPressEvent {key, sleepTime}, _modifier {modifier} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    KeySym keySym;
-    switch (_modifier) {
-      using enum Modifiers;
-      case SHIFT: {
-        keySym = XKeysymToKeycode(display, XK_Shift_L);
-        break;
-      }
-      case CTRL: {
-        keySym = XKeysymToKeycode(display, XK_Control_L);
-        break;
-      }
-    }
-    XTestFakeKeyEvent(display, keySym, True, CurrentTime);
-    XSync(display, False);
-    KeyPressEvent::solve(display, window);
-    XTestFakeKeyEvent(display, keySym, False, CurrentTime);
-    XSync(display, False);
+  auto solve(InputBackend& backend) -> void {
+    auto const modifierKey = _modifier == Modifiers::SHIFT ? Keys::SHIFT : Keys::CONTROL;
+    backend.perform(Action::key(modifierKey, true));
+    KeyPressEvent::solve(backend);
+    backend.perform(Action::key(modifierKey, false));
   }
 
 private:
@@ -474,18 +392,18 @@ public:
   CommandEvent(CommandEvent&&) noexcept = default;
   explicit CommandEvent(std::string const& _other) : _command {_other} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    KeyPressEvent('~', sleepTime).solve(display, window);
+  auto solve(InputBackend& backend) -> void {
+    KeyPressEvent('~', sleepTime).solve(backend);
     for (auto const& c : _command) {
       if (c == '_') {
-        KeyCombinationEvent(c, sleepTime, KeyCombinationEvent::Modifiers::SHIFT).solve(display, window);
+        KeyCombinationEvent(c, sleepTime, KeyCombinationEvent::Modifiers::SHIFT).solve(backend);
       } else {
-        KeyPressEvent(c, sleepTime).solve(display, window);
+        KeyPressEvent(c, sleepTime).solve(backend);
       }
     }
-    KeyPressEvent(10, sleepTime).solve(display, window);
-    KeyPressEvent(27, sleepTime).solve(display, window);
-    usleep(5000);
+    KeyPressEvent(Keys::RETURN, sleepTime).solve(backend);
+    KeyPressEvent(Keys::ESCAPE, sleepTime).solve(backend);
+    backend.perform(Action::wait(Action::Delay {5000}));
   }
 
 private:
@@ -500,9 +418,9 @@ public:
   RotationEvent(RotationEvent&&) noexcept = default;
   RotationEvent(float xAngle, float yAngle) : _xAngle {xAngle}, _yAngle {yAngle} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    FullStrafeEvent(Point {static_cast<int>(_xAngle * degreeToPixelRatio), 0}, 20, 2, sleepTime).solve(display, window);
-    FullStrafeEvent(Point {0, static_cast<int>(_yAngle * degreeToPixelRatio)}, 20, 2, sleepTime).solve(display, window);
+  auto solve(InputBackend& backend) -> void {
+    FullStrafeEvent(Point {static_cast<int>(_xAngle * degreeToPixelRatio), 0}, 20, 2, sleepTime).solve(backend);
+    FullStrafeEvent(Point {0, static_cast<int>(_yAngle * degreeToPixelRatio)}, 20, 2, sleepTime).solve(backend);
   }
 
 private:
@@ -543,14 +461,14 @@ public:
   MovementEvent(MovementEvent&&) noexcept = default;
   MovementEvent(Vector const& vector, int duration) : Movement(vector), _duration {duration} {}
 
-  auto solve(Display* display, Window window) -> void override {
+  auto solve(InputBackend& backend) -> void {
     auto inputs = getKeys();
     for (auto const& input : inputs) {
-      KeyActionEvent(input, 50, true).solve(display, window);
+      KeyActionEvent(input, 50, true).solve(backend);
     }
-    usleep(_duration);
+    backend.perform(Action::wait(Action::Delay {_duration}));
     for (auto const& input : inputs) {
-      KeyActionEvent(input, 50, false).solve(display, window);
+      KeyActionEvent(input, 50, false).solve(backend);
     }
   }
 
@@ -565,14 +483,14 @@ public:
   JumpEvent(JumpEvent&&) noexcept = default;
   JumpEvent(Vector const& vector, bool crouched) : Movement {vector}, _crouched {crouched} {}
 
-  auto solve(Display* display, Window window) -> void override {
-    KeyPressEvent(' ', sleepTime).solve(display, window);
+  auto solve(InputBackend& backend) -> void {
+    KeyPressEvent(' ', sleepTime).solve(backend);
     auto inputs = getKeys();
     for (auto const& input : inputs) {
       if (_crouched) {
-        KeyCombinationEvent(input, sleepTime, KeyCombinationEvent::Modifiers::CTRL).solve(display, input);
+        KeyCombinationEvent(input, sleepTime, KeyCombinationEvent::Modifiers::CTRL).solve(backend);
       } else {
-        KeyPressEvent(input, sleepTime).solve(display, input);
+        KeyPressEvent(input, sleepTime).solve(backend);
       }
     }
   }
@@ -588,9 +506,13 @@ public:
   BuyEvent() = default;
   BuyEvent(BuyEvent const&) = default;
   BuyEvent(BuyEvent&&) noexcept = default;
-  BuyEvent(std::vector<Item> const& items) : _itemsToBuy {items} {}
 
-  auto solve(Display* display, Window window) -> void override {
+  auto add(Item item) -> void {
+    assert(_itemCount < maxItems && "Too many items in a single buy event");
+    _itemsToBuy[_itemCount++] = item;
+  }
+
+  auto solve(InputBackend& backend) -> void {
     auto toString = [](Item item) -> std::string {
       switch (item) {
         using enum Item;
@@ -606,24 +528,45 @@ public:
       }
     };
 
-    KeyPressEvent('b', sleep).solve(display, window);
-    for (auto const& item : _itemsToBuy) {
+    KeyPressEvent('b', sleep).solve(backend);
+    for (auto const& item : std::span {_itemsToBuy}.first(_itemCount)) {
       log("Decided to buy" + toString(item), OpState::INFO);
       for (auto const& key : menuCombination.at(item)) {
-        KeyPressEvent(key, sleep).solve(display, window);
-        usleep(sleep);
+        KeyPressEvent(key, sleep).solve(backend);
+        backend.perform(Action::wait(Action::Delay {sleep}));
       }
-      usleep(sleep);
+      backend.perform(Action::wait(Action::Delay {sleep}));
     }
-    KeyPressEvent(27, sleep).solve(display, window);
+    KeyPressEvent(Keys::ESCAPE, sleep).solve(backend);
   }
 
 private:
-  std::vector<Item> _itemsToBuy;
+  static constexpr Size maxItems = 3;
+  std::array<Item, maxItems> _itemsToBuy {};
+  Size _itemCount {};
   static const std::map<Item, std::string> menuCombination;
   static constexpr auto sleep = 2500;
 };
 
 std::map<BuyEvent::Item, std::string> const BuyEvent::menuCombination = {
     {BuyEvent::Item::KEVLAR, "11"}, {BuyEvent::Item::KEVLAR_HELMET, "12"}, {BuyEvent::Item::AK_47, "42"}};
+
+using AnyEvent = std::variant<EmptyEvent, MouseScanEvent, MouseMoveEvent, StrafeEvent, FullStrafeEvent, ScreenshotEvent,
+                              MouseActionEvent, MouseClickEvent, MouseHoldEvent, ShootEvent, SprayEvent, KeyActionEvent,
+                              KeyPressEvent, KeyCombinationEvent, CommandEvent, RotationEvent, MovementEvent, JumpEvent,
+                              BuyEvent>;
+
+[[nodiscard]] inline auto isEmpty(AnyEvent const& event) -> bool { return std::holds_alternative<EmptyEvent>(event); }
+
+//indexed like the alternatives of AnyEvent
+inline constexpr std::array<char const*, std::variant_size_v<AnyEvent>> eventNames {
+    "EmptyEvent", "MouseScanEvent", "MouseMoveEvent", "StrafeEvent", "FullStrafeEvent", "ScreenshotEvent",
+    "MouseActionEvent", "MouseClickEvent", "MouseHoldEvent", "ShootEvent", "SprayEvent", "KeyActionEvent",
+    "KeyPressEvent", "KeyCombinationEvent", "CommandEvent", "RotationEvent", "MovementEvent", "JumpEvent", "BuyEvent"};
+
+[[nodiscard]] inline auto eventName(AnyEvent const& event) -> char const* { return eventNames[event.index()]; }
+
+inline auto solve(AnyEvent& event, InputBackend& backend) -> void {
+  std::visit([&backend](auto& e) { e.solve(backend); }, event);
+}
 } // namespace gabe
@@ -0,0 +1,86 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Event.hpp"
+#include "utils/trace/Trace.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace gabe {
+//fifo over a ring of event slots; slots are reused between ticks and storage only grows when the ring is full
+class EventQueue {
+public:
+  struct Entry {
+    AnyEvent event;
+    //trace timestamp of the push and the flow the event belongs to, 0 when untraced
+    uint64 enqueuedAt;
+    uint64 flow;
+  };
+
+  EventQueue(EventQueue const&) = delete;
+  EventQueue(EventQueue&&) noexcept = default;
+
+  explicit EventQueue(Size initialCapacity = defaultCapacity) :
+      _slots(std::max<Size>(initialCapacity, 1)), _stamps(_slots.size()) {}
+
+  [[nodiscard]] auto empty() const -> bool { return _count == 0; }
+  [[nodiscard]] auto size() const -> Size { return _count; }
+  [[nodiscard]] auto capacity() const -> Size { return _slots.size(); }
+
+  auto push(AnyEvent&& event, uint64 flow = 0) -> void {
+    if (_count == _slots.size()) {
+      grow();
+    }
+    auto const tail = (_head + _count) % _slots.size();
+    refill(_slots[tail], std::move(event));
+    _stamps[tail] = {utils::trace::enabled() ? utils::trace::ticks() : 0, flow};
+    ++_count;
+  }
+
+  auto pop() -> Entry {
+    assert(!empty() && "Popping from an empty event queue");
+    Entry entry {std::move(_slots[_head]), _stamps[_head].enqueuedAt, _stamps[_head].flow};
+    refill(_slots[_head], EmptyEvent {});
+    _head = (_head + 1) % _slots.size();
+    --_count;
+    return entry;
+  }
+
+private:
+  static constexpr Size defaultCapacity = 64;
+
+  struct Stamp {
+    uint64 enqueuedAt {};
+    uint64 flow {};
+  };
+
+  //events declare their constructors explicitly and are not assignable, so slots are rebuilt in place
+  static auto refill(AnyEvent& slot, AnyEvent&& event) -> void {
+    std::destroy_at(&slot);
+    std::construct_at(&slot, std::move(event));
+  }
+
+  auto grow() -> void {
+    std::vector<AnyEvent> slots(_slots.size() * 2);
+    std::vector<Stamp> stamps(slots.size());
+    for (Size idx = 0; idx < _count; ++idx) {
+      refill(slots[idx], std::move(_slots[(_head + idx) % _slots.size()]));
+      stamps[idx] = _stamps[(_head + idx) % _slots.size()];
+    }
+    _slots = std::move(slots);
+    _stamps = std::move(stamps);
+    _head = 0;
+  }
+
+  std::vector<AnyEvent> _slots;
+  std::vector<Stamp> _stamps;
+  Size _head {};
+  Size _count {};
+};
+} // namespace gabe
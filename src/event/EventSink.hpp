@@ -0,0 +1,19 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Event.hpp"
+#include "types.hpp"
+
+namespace gabe {
+//destination of the events produced by the decision trees
+class EventSink {
+public:
+  virtual ~EventSink() = default;
+
+  //flow ties the event to the captured frame it was decided on, for tracing
+  virtual auto addEvent(AnyEvent&& event, uint64 flow = 0) -> void = 0;
+};
+} // namespace gabe
@@ -0,0 +1,20 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+#include <exception>
+
+namespace gabe::backend {
+
+class DeviceOpeningException : public std::exception {
+public:
+  [[nodiscard]] char const* what() const noexcept override { return "Could not open the uinput device"; }
+};
+
+class DeviceCreationException : public std::exception {
+public:
+  [[nodiscard]] char const* what() const noexcept override { return "Could not create the virtual input device"; }
+};
+
+} // namespace gabe::backend
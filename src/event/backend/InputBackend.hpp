@@ -0,0 +1,89 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "types.hpp"
+#include "utils/math/geometry/Geometry.hpp"
+#include <chrono>
+#include <vector>
+
+namespace gabe {
+//keys without a character of their own, given control codes the printable keys never use
+struct Keys {
+  static constexpr char RETURN = '\n';
+  static constexpr char SHIFT = 14;
+  static constexpr char CONTROL = 17;
+  static constexpr char ESCAPE = 27;
+};
+
+//one primitive input; its delay is waited after it is performed, so a sequence of actions carries its own timing
+struct Action {
+  enum class Type : uint8 { FOCUS, MOTION, BUTTON, KEY, WAIT };
+  using Delay = std::chrono::microseconds;
+
+  static constexpr auto focus() -> Action { return {Type::FOCUS}; }
+  static constexpr auto motion(Point const& point, Delay delay = {}) -> Action {
+    return {Type::MOTION, point, 0, false, delay};
+  }
+  //buttons use the X numbering, 1 to 5
+  static constexpr auto button(int button, bool press, Delay delay = {}) -> Action {
+    return {Type::BUTTON, {}, button, press, delay};
+  }
+  static constexpr auto key(char key, bool press, Delay delay = {}) -> Action {
+    return {Type::KEY, {}, key, press, delay};
+  }
+  static constexpr auto wait(Delay delay) -> Action { return {Type::WAIT, {}, 0, false, delay}; }
+
+  Type type {Type::WAIT};
+  Point point {};
+  int code {};
+  bool press {};
+  Delay delay {};
+};
+
+//where events send their inputs and take screen captures from
+class InputBackend {
+public:
+  virtual ~InputBackend() = default;
+
+  //performs the action, then lets its delay pass
+  virtual auto perform(Action const& action) -> void = 0;
+
+  //writes the screen as packed RGB into the given buffer; backends without a screen leave it untouched and return false
+  virtual auto capture(unsigned char*, Size) -> bool { return false; }
+
+  virtual auto pointer() -> Point { return {}; }
+};
+
+//discards every action without waiting
+class NullBackend : public InputBackend {
+public:
+  auto perform(Action const&) -> void override {}
+};
+
+//keeps every action with the virtual time it was performed at; delays advance the virtual clock instead of sleeping,
+//so event execution can be tested and benchmarked without a display
+class RecordingBackend : public InputBackend {
+public:
+  struct Performed {
+    Action action;
+    Action::Delay time;
+  };
+
+  auto perform(Action const& action) -> void override {
+    _performed.push_back({action, _now});
+    _now += action.delay;
+  }
+
+  [[nodiscard]] auto performed() const -> std::vector<Performed> const& { return _performed; }
+  [[nodiscard]] auto now() const -> Action::Delay { return _now; }
+
+  auto clear() -> void { _performed.clear(); }
+
+private:
+  std::vector<Performed> _performed {};
+  Action::Delay _now {};
+};
+} // namespace gabe
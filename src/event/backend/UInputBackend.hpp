@@ -0,0 +1,155 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Exceptions.hpp"
+#include "InputBackend.hpp"
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/uinput.h>
+#include <string>
+#include <sys/ioctl.h>
+#include <thread>
+#include <unistd.h>
+
+namespace gabe {
+//injects input through a virtual mouse and keyboard created with uinput, below the display server. Motion is
+//relative, which is how the game reads the mouse; focus is left to the display server and nothing can be captured,
+//so capturing is delegated to another backend when one is given
+class UInputBackend : public InputBackend {
+public:
+  UInputBackend() = delete;
+  UInputBackend(UInputBackend const&) = delete;
+  UInputBackend(UInputBackend&&) noexcept = delete;
+
+  explicit UInputBackend(InputBackend* pScreen = nullptr,
+                         std::string const& devicePath = "/dev/uinput") noexcept(false) :
+      _pScreen {pScreen}, _fd {open(devicePath.c_str(), O_WRONLY | O_NONBLOCK)} {
+    if (_fd < 0) {
+      throw backend::DeviceOpeningException {};
+    }
+
+    ioctl(_fd, UI_SET_EVBIT, EV_KEY);
+    ioctl(_fd, UI_SET_EVBIT, EV_REL);
+    ioctl(_fd, UI_SET_RELBIT, REL_X);
+    ioctl(_fd, UI_SET_RELBIT, REL_Y);
+    ioctl(_fd, UI_SET_RELBIT, REL_WHEEL);
+    for (auto button : {BTN_LEFT, BTN_RIGHT, BTN_MIDDLE}) {
+      ioctl(_fd, UI_SET_KEYBIT, button);
+    }
+    for (int key = KEY_ESC; key <= KEY_KPDOT; ++key) {
+      ioctl(_fd, UI_SET_KEYBIT, key);
+    }
+
+    uinput_setup setup {};
+    setup.id.bustype = BUS_USB;
+    std::strncpy(setup.name, "gabe virtual input", UINPUT_MAX_NAME_SIZE - 1);
+    if (ioctl(_fd, UI_DEV_SETUP, &setup) < 0 || ioctl(_fd, UI_DEV_CREATE) < 0) {
+      close(_fd);
+      throw backend::DeviceCreationException {};
+    }
+  }
+
+  ~UInputBackend() override {
+    ioctl(_fd, UI_DEV_DESTROY);
+    close(_fd);
+  }
+
+  auto perform(Action const& action) -> void override {
+    switch (action.type) {
+      using enum Action::Type;
+      case FOCUS:
+      case WAIT: {
+        break;
+      }
+      case MOTION: {
+        emit(EV_REL, REL_X, action.point.x);
+        emit(EV_REL, REL_Y, action.point.y);
+        emit(EV_SYN, SYN_REPORT, 0);
+        break;
+      }
+      case BUTTON: {
+        button(action.code, action.press);
+        break;
+      }
+      case KEY: {
+        if (auto code = keyCode(static_cast<char>(action.code)); code >= 0) {
+          emit(EV_KEY, code, action.press ? 1 : 0);
+          emit(EV_SYN, SYN_REPORT, 0);
+        }
+        break;
+      }
+    }
+    if (action.delay.count() > 0) {
+      std::this_thread::sleep_for(action.delay);
+    }
+  }
+
+  auto capture(unsigned char* target, Size size) -> bool override {
+    return _pScreen != nullptr && _pScreen->capture(target, size);
+  }
+
+  auto pointer() -> Point override { return _pScreen != nullptr ? _pScreen->pointer() : Point {}; }
+
+private:
+  auto emit(int type, int code, int value) -> void {
+    input_event event {};
+    event.type = type;
+    event.code = code;
+    event.value = value;
+    write(_fd, &event, sizeof(event));
+  }
+
+  //X buttons 4 and 5 are the wheel, which only scrolls on press
+  auto button(int xButton, bool press) -> void {
+    switch (xButton) {
+      case 1: emit(EV_KEY, BTN_LEFT, press ? 1 : 0); break;
+      case 2: emit(EV_KEY, BTN_RIGHT, press ? 1 : 0); break;
+      case 3: emit(EV_KEY, BTN_MIDDLE, press ? 1 : 0); break;
+      case 4:
+      case 5: {
+        if (!press) {
+          return;
+        }
+        emit(EV_REL, REL_WHEEL, xButton == 4 ? 1 : -1);
+        break;
+      }
+      default: return;
+    }
+    emit(EV_SYN, SYN_REPORT, 0);
+  }
+
+  //linux key codes of the characters events type; -1 for the ones without a key
+  static auto keyCode(char key) -> int {
+    static constexpr std::array letters {KEY_A, KEY_B, KEY_C, KEY_D, KEY_E, KEY_F, KEY_G, KEY_H, KEY_I,
+                                         KEY_J, KEY_K, KEY_L, KEY_M, KEY_N, KEY_O, KEY_P, KEY_Q, KEY_R,
+                                         KEY_S, KEY_T, KEY_U, KEY_V, KEY_W, KEY_X, KEY_Y, KEY_Z};
+    if (key >= 'a' && key <= 'z') {
+      return letters[key - 'a'];
+    }
+    if (key >= '1' && key <= '9') {
+      return KEY_1 + (key - '1');
+    }
+    switch (key) {
+      case '0': return KEY_0;
+      case ' ': return KEY_SPACE;
+      case '~':
+      case '`': return KEY_GRAVE;
+      case '_':
+      case '-': return KEY_MINUS;
+      case '.': return KEY_DOT;
+      case Keys::RETURN: return KEY_ENTER;
+      case Keys::ESCAPE: return KEY_ESC;
+      case Keys::SHIFT: return KEY_LEFTSHIFT;
+      case Keys::CONTROL: return KEY_LEFTCTRL;
+      default: return -1;
+    }
+  }
+
+  InputBackend* _pScreen;
+  int _fd;
+};
+} // namespace gabe
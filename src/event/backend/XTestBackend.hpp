@@ -0,0 +1,106 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "InputBackend.hpp"
+#include <X11/Xutil.h>
+#include <X11/extensions/XTest.h>
+#include <cassert>
+#include <thread>
+
+namespace gabe {
+//fakes input through the XTest extension and captures the target window through Xlib
+class XTestBackend : public InputBackend {
+public:
+  XTestBackend() = delete;
+  XTestBackend(XTestBackend const&) = delete;
+  XTestBackend(XTestBackend&&) noexcept = delete;
+
+  XTestBackend(Display* display, Window window) : _display {display}, _window {window} {
+    XSelectInput(_display, _window, PointerMotionMask);
+    XFlush(_display);
+  }
+
+  auto perform(Action const& action) -> void override {
+    switch (action.type) {
+      using enum Action::Type;
+      case FOCUS: {
+        XSetInputFocus(_display, _window, RevertToParent, CurrentTime);
+        XFlush(_display);
+        break;
+      }
+      case MOTION: {
+        XTestFakeMotionEvent(_display, -1, action.point.x, action.point.y, CurrentTime);
+        XFlush(_display);
+        break;
+      }
+      case BUTTON: {
+        XTestFakeButtonEvent(_display, action.code, action.press, CurrentTime);
+        XFlush(_display);
+        break;
+      }
+      case KEY: {
+        XTestFakeKeyEvent(_display, keyCode(static_cast<char>(action.code)), action.press, CurrentTime);
+        XSync(_display, False);
+        break;
+      }
+      case WAIT: {
+        break;
+      }
+    }
+    if (action.delay.count() > 0) {
+      std::this_thread::sleep_for(action.delay);
+    }
+  }
+
+  auto capture(unsigned char* target, Size size) -> bool override {
+    XWindowAttributes attr;
+    XGetWindowAttributes(_display, _window, &attr);
+    assert(attr.width == expectedScreenWidth && attr.height == expectedScreenHeight
+           && "Window does not match expected sizes");
+    assert(size >= static_cast<Size>(attr.width) * attr.height * 3 && "Capture target too small");
+
+    XImage* img = XGetImage(_display, _window, 0, 0, attr.width, attr.height, AllPlanes, ZPixmap);
+    char const* data = img->data;
+    int bytesPerPixel = img->bits_per_pixel / 8;
+    int bytesPerLine = img->bytes_per_line;
+    for (int y = 0; y < attr.height; ++y) {
+      for (int x = 0; x < attr.width; ++x) {
+        int offset = y * bytesPerLine + x * bytesPerPixel;
+        int jpgOffset = y * attr.width * 3 + x * 3;
+
+        target[jpgOffset + 0] = data[offset + 2];
+        target[jpgOffset + 1] = data[offset + 1];
+        target[jpgOffset + 2] = data[offset + 0];
+      }
+    }
+    XDestroyImage(img);
+    return true;
+  }
+
+  auto pointer() -> Point override {
+    Window root;
+    Window childWindow;
+    int rootX, rootY, winX, winY;
+    unsigned int mask;
+    XQueryPointer(_display, _window, &root, &childWindow, &rootX, &rootY, &winX, &winY, &mask);
+    return {winX, winY};
+  }
+
+private:
+  auto keyCode(char key) -> KeyCode {
+    switch (key) {
+      case Keys::RETURN: return XKeysymToKeycode(_display, XK_Return);
+      case Keys::ESCAPE: return XKeysymToKeycode(_display, XK_Escape);
+      case Keys::SHIFT: return XKeysymToKeycode(_display, XK_Shift_L);
+      case Keys::CONTROL: return XKeysymToKeycode(_display, XK_Control_L);
+      default: return XKeysymToKeycode(_display, static_cast<KeySym>(key));
+    }
+  }
+
+  Display* _display;
+  Window _window;
+};
+} // namespace gabe
@@ -30,7 +30,7 @@ public:
   [[nodiscard]] auto currentWeaponState() const -> ActiveWeaponState { return _activeWeaponState; }
   [[nodiscard]] auto currentWeaponClass() const -> WeaponClass { return _activeWeaponClass; }
 
-  [[nodiscard]] auto weapons() const { return _weapons; }
+  [[nodiscard]] auto weapons() const -> std::array<InventoryWeapon, 4> const& { return _weapons; }
 
   auto jsonUpdate(cds::json::JsonObject const& jsonObject) noexcept(false) -> void {
     using namespace cds;
@@ -0,0 +1,80 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "types.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace gabe {
+//lock free triple buffer between one capturing and one consuming thread: the producer always has a free slot to
+//write into, the consumer keeps reading its slot until it asks for a newer one and frames are never copied
+class FrameRing {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Frame {
+    unsigned char const* data {};
+    //0 until the first frame is published
+    uint64 sequence {};
+    Clock::time_point captureTime {};
+  };
+
+  FrameRing() = delete;
+  FrameRing(FrameRing const&) = delete;
+  FrameRing(FrameRing&&) noexcept = delete;
+
+  explicit FrameRing(Size frameSize) : _frameSize {frameSize}, _storage(frameSize * slotCount) {}
+
+  //producer side; a capture is claimed before it is handed to another thread so that at most one is in flight
+  [[nodiscard]] auto beginCapture() -> bool { return !_capturing.exchange(true, std::memory_order_acq_rel); }
+  [[nodiscard]] auto captureBuffer() -> unsigned char* { return slot(_back); }
+
+  //returns the sequence number given to the frame
+  auto publish(Clock::time_point captureTime) -> uint64 {
+    auto const sequence = ++_publishedCount;
+    _metadata[_back] = {sequence, captureTime};
+    _back = _ready.exchange(_back | freshBit, std::memory_order_acq_rel) & indexMask;
+    _capturing.store(false, std::memory_order_release);
+    return sequence;
+  }
+
+  //gives up a claimed capture without publishing anything
+  auto cancelCapture() -> void { _capturing.store(false, std::memory_order_release); }
+
+  //consumer side; the returned frame stays untouched until the next call
+  [[nodiscard]] auto latest() -> Frame {
+    if ((_ready.load(std::memory_order_relaxed) & freshBit) != 0) {
+      _front = _ready.exchange(_front, std::memory_order_acq_rel) & indexMask;
+    }
+    return {slot(_front), _metadata[_front].sequence, _metadata[_front].captureTime};
+  }
+
+  [[nodiscard]] auto frameSize() const -> Size { return _frameSize; }
+
+private:
+  static constexpr Size slotCount = 3;
+  static constexpr uint8 indexMask = 0b011;
+  static constexpr uint8 freshBit = 0b100;
+
+  struct Metadata {
+    uint64 sequence {};
+    Clock::time_point captureTime {};
+  };
+
+  auto slot(uint8 idx) -> unsigned char* { return _storage.data() + idx * _frameSize; }
+
+  Size _frameSize;
+  std::vector<unsigned char> _storage;
+  std::array<Metadata, slotCount> _metadata {};
+  uint8 _front {0};
+  uint8 _back {1};
+  std::atomic<uint8> _ready {2};
+  std::atomic<bool> _capturing {false};
+  uint64 _publishedCount {};
+};
+} // namespace gabe
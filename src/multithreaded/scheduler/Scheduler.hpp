@@ -0,0 +1,315 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "multithreaded/threadPool/ThreadPool.hpp"
+#include "types.hpp"
+#include "utils/logger/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gabe {
+//bitmasks of the shared resources a task reads and writes; tasks conflict when one writes what the other touches
+struct ResourceAccess {
+  static constexpr uint64 all = ~0ull;
+
+  uint64 reads {all};
+  uint64 writes {all};
+
+  [[nodiscard]] constexpr auto conflictsWith(ResourceAccess const& other) const -> bool {
+    return (writes & (other.reads | other.writes)) != 0 || (reads & other.writes) != 0;
+  }
+
+  constexpr auto operator|(ResourceAccess const& other) const -> ResourceAccess {
+    return {reads | other.reads, writes | other.writes};
+  }
+};
+
+//Runs periodic tasks, each with its own period and deadline. The scheduling thread sleeps until the earliest
+//release or until notify() is called, so nothing spins while idle. Lateness, runtime and deadline overruns are
+//recorded for every task.
+//With a worker pool, the tasks due in one pass form a graph: a task waits for every earlier added task it conflicts
+//with, and tasks without conflicts between them run concurrently.
+class Scheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  struct Timing {
+    Duration period;
+    Duration deadline;
+    bool wakeOnNotification {false};
+  };
+
+  struct Statistics {
+    Size ticks {0};
+    Size overruns {0};
+    Size skippedReleases {0};
+    Duration worstLateness {0};
+    Duration worstRuntime {0};
+    Duration totalRuntime {0};
+  };
+
+  Scheduler() = default;
+  Scheduler(Scheduler const&) = delete;
+  Scheduler(Scheduler&&) noexcept = delete;
+  explicit Scheduler(Size workerCount) : _pool {std::make_unique<ThreadPool>(workerCount)} {}
+
+  auto addTask(std::string const& name, Timing const& timing, std::function<void()>&& tick,
+               ResourceAccess const& access = {}) -> void {
+    _tasks.push_back(Task {name, timing, access, std::move(tick), Clock::now(), {}});
+  }
+
+  //while the gate is closed no task is released; the scheduler waits for a notification instead
+  auto setGate(std::function<bool()>&& gate) -> void { _gate = std::move(gate); }
+
+  auto notify() -> void {
+    std::lock_guard lockGuard {_mutex};
+    _notified = true;
+    _conditionVariable.notify_one();
+  }
+
+  //waits for the next release or notification, then runs every due task in the order they were added
+  //returns the number of tasks which ran
+  auto runOnce() -> Size {
+    if (_gate && !_gate()) {
+      waitForNotification(Clock::now() + gatePollInterval);
+      _gateClosed = true;
+      return 0;
+    }
+    if (std::exchange(_gateClosed, false)) {
+      auto now = Clock::now();
+      for (auto& task : _tasks) {
+        task.release = now;
+      }
+    }
+
+    auto nextRelease = Clock::time_point::max();
+    for (auto const& task : _tasks) {
+      nextRelease = std::min(nextRelease, task.release);
+    }
+    auto notified = waitForNotification(nextRelease);
+
+    std::vector<Release> due {};
+    auto now = Clock::now();
+    for (auto& task : _tasks) {
+      if (task.release <= now) {
+        due.emplace_back(&task, task.release);
+      } else if (notified && task.timing.wakeOnNotification) {
+        due.emplace_back(&task, now);
+      }
+    }
+
+    if (_pool == nullptr || due.size() < 2) {
+      for (auto const& [task, release] : due) {
+        runTask(*task, release);
+      }
+    } else {
+      runGraph(due);
+    }
+    return due.size();
+  }
+
+  //Advances a virtual clock to now instead of waiting on the steady clock: every release up to now runs at its own
+  //time, earliest first, then the tasks woken by notifications since the last step run at now. Tasks run one at a
+  //time on the calling thread and no virtual time passes while they do, so stepping through the same timestamps
+  //ticks the same tasks in the same order on every run. The first step starts the clock, releasing every task at now
+  //returns the number of tasks which ran
+  auto stepTo(Clock::time_point now) -> Size {
+    if (!std::exchange(_stepping, true)) {
+      for (auto& task : _tasks) {
+        task.release = now;
+      }
+    }
+    if (_gate && !_gate()) {
+      consumeNotification();
+      _gateClosed = true;
+      return 0;
+    }
+    if (std::exchange(_gateClosed, false)) {
+      for (auto& task : _tasks) {
+        task.release = now;
+      }
+    }
+
+    Size rez = 0;
+    for (auto next = std::ranges::min_element(_tasks, {}, &Task::release);
+         next != _tasks.end() && next->release <= now; next = std::ranges::min_element(_tasks, {}, &Task::release)) {
+      stepTask(*next, next->release);
+      ++rez;
+    }
+    if (consumeNotification()) {
+      for (auto& task : _tasks) {
+        if (task.timing.wakeOnNotification) {
+          stepTask(task, now);
+          ++rez;
+        }
+      }
+    }
+    return rez;
+  }
+
+  //the release stepTo is running, or the last one it ran
+  [[nodiscard]] auto steppedTime() const -> Clock::time_point { return _steppedTime; }
+
+  [[nodiscard]] auto statistics(std::string const& name) const -> Statistics {
+    for (auto const& task : _tasks) {
+      if (task.name == name) {
+        return task.statistics;
+      }
+    }
+    return {};
+  }
+
+  auto report() const -> void {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    for (auto const& [name, timing, access, tick, release, statistics] : _tasks) {
+      auto averageRuntime = statistics.ticks == 0
+          ? Duration {0}
+          : statistics.totalRuntime / static_cast<Duration::rep>(statistics.ticks);
+      log(name + ": " + std::to_string(statistics.ticks) + " ticks, " + std::to_string(statistics.overruns)
+              + " overruns, " + std::to_string(statistics.skippedReleases) + " skipped, average runtime "
+              + std::to_string(duration_cast<microseconds>(averageRuntime).count()) + "us, worst runtime "
+              + std::to_string(duration_cast<microseconds>(statistics.worstRuntime).count()) + "us, worst lateness "
+              + std::to_string(duration_cast<microseconds>(statistics.worstLateness).count()) + "us",
+          OpState::INFO);
+    }
+  }
+
+private:
+  static constexpr auto gatePollInterval = std::chrono::milliseconds {250};
+
+  struct Task {
+    std::string name;
+    Timing timing;
+    ResourceAccess access;
+    std::function<void()> tick;
+    Clock::time_point release;
+    Statistics statistics;
+  };
+
+  using Release = std::pair<Task*, Clock::time_point>;
+
+  auto runGraph(std::vector<Release> const& due) -> void {
+    std::vector<std::vector<Size>> successors(due.size());
+    std::vector<Size> pendingPredecessors(due.size(), 0);
+    for (Size idx = 0; idx < due.size(); ++idx) {
+      for (Size predecessor = 0; predecessor < idx; ++predecessor) {
+        if (due[predecessor].first->access.conflictsWith(due[idx].first->access)) {
+          successors[predecessor].push_back(idx);
+          ++pendingPredecessors[idx];
+        }
+      }
+    }
+
+    std::latch finished {static_cast<std::ptrdiff_t>(due.size())};
+    std::mutex graphMutex {};
+    std::exception_ptr failure {};
+    std::function<void(Size)> launch = [&](Size idx) {
+      _pool->submit([&, idx] {
+        //a task which throws still releases its successors, so the pass finishes before the exception is rethrown
+        std::exception_ptr thrown {};
+        try {
+          runTask(*due[idx].first, due[idx].second);
+        } catch (...) {
+          thrown = std::current_exception();
+        }
+        std::vector<Size> ready {};
+        {
+          std::lock_guard lockGuard {graphMutex};
+          if (thrown && !failure) {
+            failure = thrown;
+          }
+          for (auto successor : successors[idx]) {
+            if (--pendingPredecessors[successor] == 0) {
+              ready.push_back(successor);
+            }
+          }
+        }
+        for (auto successor : ready) {
+          launch(successor);
+        }
+        finished.count_down();
+      });
+    };
+
+    for (Size idx = 0; idx < due.size(); ++idx) {
+      if (pendingPredecessors[idx] == 0) {
+        launch(idx);
+      }
+    }
+    finished.wait();
+    if (failure) {
+      std::rethrow_exception(failure);
+    }
+  }
+
+  auto waitForNotification(Clock::time_point until) -> bool {
+    std::unique_lock lockGuard {_mutex};
+    _conditionVariable.wait_until(lockGuard, until, [this] { return _notified; });
+    return std::exchange(_notified, false);
+  }
+
+  auto consumeNotification() -> bool {
+    std::lock_guard lockGuard {_mutex};
+    return std::exchange(_notified, false);
+  }
+
+  static auto account(Task& task, Duration lateness, Duration runtime) -> void {
+    auto& statistics = task.statistics;
+    ++statistics.ticks;
+    statistics.worstLateness = std::max(statistics.worstLateness, lateness);
+    statistics.worstRuntime = std::max(statistics.worstRuntime, runtime);
+    statistics.totalRuntime += runtime;
+    if (lateness + runtime > task.timing.deadline) {
+      ++statistics.overruns;
+    }
+  }
+
+  //on the virtual clock tasks are never late and nothing is skipped; runtimes are still measured on the steady clock
+  auto stepTask(Task& task, Clock::time_point release) -> void {
+    _steppedTime = release;
+    auto const start = Clock::now();
+    task.tick();
+    account(task, Duration {0}, Clock::now() - start);
+    task.release = release + task.timing.period;
+  }
+
+  static auto runTask(Task& task, Clock::time_point release) -> void {
+    auto const start = Clock::now();
+    task.tick();
+    auto const finish = Clock::now();
+    account(task, start - release, finish - start);
+
+    //releases missed while the task was late are dropped instead of being run back to back
+    task.release = release + task.timing.period;
+    if (task.release <= finish) {
+      auto const missed = (finish - task.release) / task.timing.period + 1;
+      task.statistics.skippedReleases += static_cast<Size>(missed);
+      task.release += task.timing.period * missed;
+    }
+  }
+
+  std::vector<Task> _tasks {};
+  std::function<bool()> _gate {};
+  bool _gateClosed {false};
+  bool _stepping {false};
+  Clock::time_point _steppedTime {};
+  bool _notified {false};
+  std::mutex _mutex {};
+  std::condition_variable _conditionVariable {};
+  std::unique_ptr<ThreadPool> _pool {};
+};
+} // namespace gabe
@@ -0,0 +1,85 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "types.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+namespace gabe {
+//sequence lock around a trivially copyable value: readers never block and retry only while a write is in flight,
+//writers are serialized between themselves. The value is kept in atomic words so torn reads are discarded instead of
+//being data races (Boehm, "Can seqlocks get along with programming language memory models?")
+template <typename T>
+  requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class SeqLock {
+public:
+  SeqLock() : SeqLock(T {}) {}
+  SeqLock(SeqLock const&) = delete;
+  SeqLock(SeqLock&&) noexcept = delete;
+  explicit SeqLock(T const& value) { write(value); }
+
+  [[nodiscard]] auto load() const -> T {
+    std::array<uint64, wordCount> words;
+    while (true) {
+      auto const before = _sequence.load(std::memory_order_acquire);
+      for (Size idx = 0; idx < wordCount; ++idx) {
+        words[idx] = _words[idx].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      auto const after = _sequence.load(std::memory_order_relaxed);
+      if (before == after && (before & 1u) == 0) {
+        break;
+      }
+    }
+    Bytes bytes;
+    std::memcpy(bytes.data(), words.data(), sizeof(T));
+    return std::bit_cast<T>(bytes);
+  }
+
+  auto store(T const& value) -> void {
+    std::lock_guard lockGuard {_writerLock};
+    write(value);
+  }
+
+  //read-modify-write; concurrent modifications are applied one after the other
+  template <typename F> auto modify(F&& change) -> void {
+    std::lock_guard lockGuard {_writerLock};
+    auto value = load();
+    change(value);
+    write(value);
+  }
+
+  //incremented twice per write; readers can compare it to tell whether anything was published in between
+  [[nodiscard]] auto version() const -> uint64 { return _sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+  static constexpr Size wordCount = (sizeof(T) + sizeof(uint64) - 1) / sizeof(uint64);
+  //values go through their bytes, so types with default member initializers are never written to with memcpy
+  using Bytes = std::array<std::byte, sizeof(T)>;
+
+  auto write(T const& value) -> void {
+    std::array<uint64, wordCount> words {};
+    std::memcpy(words.data(), std::bit_cast<Bytes>(value).data(), sizeof(T));
+
+    auto const sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (Size idx = 0; idx < wordCount; ++idx) {
+      _words[idx].store(words[idx], std::memory_order_relaxed);
+    }
+    _sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  std::atomic<uint64> _sequence {0};
+  std::array<std::atomic<uint64>, wordCount> _words {};
+  std::mutex _writerLock {};
+};
+} // namespace gabe
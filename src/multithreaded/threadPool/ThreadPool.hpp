@@ -0,0 +1,77 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "types.hpp"
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace gabe {
+class ThreadPool {
+public:
+  ThreadPool() = delete;
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool(ThreadPool&&) noexcept = delete;
+
+  explicit ThreadPool(Size workerCount) {
+    _workers.reserve(workerCount);
+    for (Size idx = 0; idx < workerCount; ++idx) {
+      _workers.emplace_back([this] { workerLoop(); });
+    }
+  }
+
+  //jobs already submitted still run before the workers are joined
+  ~ThreadPool() {
+    {
+      std::lock_guard lockGuard {_mutex};
+      _stopped = true;
+    }
+    _conditionVariable.notify_all();
+  }
+
+  //the future is ready once the job ran and rethrows what the job threw, which would otherwise end the process
+  auto submit(std::function<void()>&& job) -> std::future<void> {
+    auto task = std::make_shared<std::packaged_task<void()>>(std::move(job));
+    auto rez = task->get_future();
+    {
+      std::lock_guard lockGuard {_mutex};
+      _jobs.push([task] { (*task)(); });
+    }
+    _conditionVariable.notify_one();
+    return rez;
+  }
+
+  [[nodiscard]] auto size() const -> Size { return _workers.size(); }
+
+private:
+  auto workerLoop() -> void {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock lockGuard {_mutex};
+        _conditionVariable.wait(lockGuard, [this] { return _stopped || !_jobs.empty(); });
+        if (_jobs.empty()) {
+          return;
+        }
+        job = std::move(_jobs.front());
+        _jobs.pop();
+      }
+      job();
+    }
+  }
+
+  std::mutex _mutex {};
+  std::condition_variable _conditionVariable {};
+  std::queue<std::function<void()>> _jobs {};
+  bool _stopped {false};
+  std::vector<std::jthread> _workers {};
+};
+} // namespace gabe
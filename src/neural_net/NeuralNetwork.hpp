@@ -7,7 +7,8 @@
 #include "layer/ConvolutionalLayer.hpp"
 #include "layer/Layer.hpp"
 #include "utils/data/Data.hpp"
-#include <random>
+#include "utils/data/sampler/Sampler.hpp"
+#include "utils/random/Random.hpp"
 
 namespace gabe::nn {
 
@@ -15,6 +16,7 @@ template <typename DataType, typename InputLayer, typename... Layers> class Neur
     public impl::LayerPair<DataType, InputLayer, Layers...> {
   template <typename InputLayerType> using ImageDataSet = utils::data::ImageDataSet<InputLayerType>;
   template <typename InputLayerType> using YoloDataSet = utils::data::YoloDataSet<InputLayerType>;
+  template <typename DataSetType> using BatchSampler = utils::data::BatchSampler<DataSetType>;
 
 private:
   using LayerPair = impl::LayerPair<DataType, InputLayer, Layers...>;
@@ -23,11 +25,10 @@ public:
   using impl::LayerPair<DataType, InputLayer, Layers...>::backPropagate;
   using impl::LayerPair<DataType, InputLayer, Layers...>::feedForward;
 
-  auto randomize_weights(double lower_end, double higher_end) {
-    auto transformer = [lower_end, higher_end](DataType) {
-      static std::random_device randomDevice {};
-      static std::uniform_real_distribution dist(lower_end, higher_end);
-      return dist(randomDevice);
+  auto randomize_weights(double lower_end, double higher_end, uint64 seed = nextInitializationSeed()) {
+    utils::random::Xoshiro256 generator {seed};
+    auto transformer = [lower_end, higher_end, &generator](DataType) {
+      return static_cast<DataType>(lower_end + (higher_end - lower_end) * generator.canonical());
     };
 
     LayerPair::randomize_weights(transformer);
@@ -43,6 +44,19 @@ public:
     }
   }
 
+  template <typename Input, typename LabelEncoderType>
+  auto backPropagate(Size epochCount, DataType learningRate, ImageDataSet<Input> const& dataSet,
+                     BatchSampler<ImageDataSet<Input>>& sampler, LabelEncoderType&& labelEncoder) -> void {
+    assert(sampler.size() == dataSet.data().size() && "Sampler was built for a different data set");
+    for (Size idx = 0; idx < epochCount; ++idx) {
+      sampler.reshuffle(idx);
+      for (auto sampleIdx : sampler.indices()) {
+        auto const& e = dataSet.data()[sampleIdx];
+        backPropagate(e.data, labelEncoder(e.label), learningRate);
+      }
+    }
+  }
+
   template <typename Input, typename LabelEncoder>
   auto backPropagateWithSerialization(Size epochCount, DataType learningRate, ImageDataSet<Input> const& dataSet,
                                       LabelEncoder&& labelEncoder, std::string const& serializationFile) -> void {
@@ -74,6 +88,26 @@ public:
     }
   }
 
+  template <typename Input, typename Clipper>
+  auto yoloBackPropagateWithSerialization(Size epochCount, DataType learningRate, YoloDataSet<Input> const& dataSet,
+                                          BatchSampler<YoloDataSet<Input>>& sampler,
+                                          std::string const& serializationFile, Clipper&& clipper) -> void {
+    assert(sampler.size() == dataSet.data().size() && "Sampler was built for a different data set");
+    for (Size idx = 0, propIdx = 0; idx < epochCount; ++idx) {
+      sampler.reshuffle(idx);
+      for (auto sampleIdx : sampler.indices()) {
+        auto const& e = dataSet.data()[sampleIdx];
+        backPropagate(e.data, e.labels, learningRate, std::forward<Clipper>(clipper));
+        ++propIdx;
+
+        if (propIdx % 50 == 0) {
+          std::cout << "Serializing inside " + serializationFile + std::to_string(propIdx) + "\n";
+          serialize(serializationFile + std::to_string(propIdx));
+        }
+      }
+    }
+  }
+
   template <typename InputLayerType, typename LabelDecoderType>
   auto validate(ImageDataSet<InputLayerType> const& dataSet, LabelDecoderType&& labelDecoder) -> double {
     double error = .0;
@@ -5,76 +5,178 @@
 #pragma once
 
 #include "utils/concepts/Concepts.hpp"
+#include "utils/math/linearArray/LinearArray.hpp"
+#include "utils/random/Random.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <random>
+#include <thread>
+#include <vector>
 
 namespace gabe::nn {
+namespace impl {
+inline auto initializationSeeds() -> std::atomic<uint64>& {
+  static std::atomic<uint64> seeds {static_cast<uint64>(std::random_device {}()) << 32 | std::random_device {}()};
+  return seeds;
+}
+
+//one tensor's slice of a counter-based generator; value idx of the tensor always comes from block idx / 4,
+//so the result does not depend on how the fill is split between threads
+class TensorStream {
+public:
+  static constexpr Size parallelThreshold = 1 << 16;
+
+  TensorStream(utils::random::Philox4x32 const& generator, uint64 stream) : _generator {generator}, _stream {stream} {}
+
+  template <typename T, typename Transform> auto fill(T& in, Transform&& transform) const -> void {
+    auto values = utils::math::linearArray::flatView(in);
+    auto fillBlocks = [this, &values, &transform](Size begin, Size end) {
+      for (auto blockIdx = begin; blockIdx < end; ++blockIdx) {
+        auto block = transform(_generator(blockIdx, _stream));
+        auto const offset = blockIdx * block.size();
+        auto const count = std::min(block.size(), values.size() - offset);
+        std::copy_n(block.begin(), count, values.begin() + offset);
+      }
+    };
+
+    Size const blockCount = (values.size() + 3) / 4;
+    Size const threadCount = values.size() < parallelThreshold
+        ? 1
+        : std::clamp<Size>(std::thread::hardware_concurrency(), 1, blockCount / (parallelThreshold / 4));
+    if (threadCount == 1) {
+      fillBlocks(0, blockCount);
+      return;
+    }
+    std::vector<std::jthread> threads {};
+    threads.reserve(threadCount);
+    for (Size idx = 0; idx < threadCount; ++idx) {
+      threads.emplace_back(fillBlocks, blockCount * idx / threadCount, blockCount * (idx + 1) / threadCount);
+    }
+  }
+
+  template <typename T> auto uniform(T& in, typename T::UnderlyingType lower, typename T::UnderlyingType upper) const {
+    using U = typename T::UnderlyingType;
+    fill(in, [lower, upper](utils::random::Philox4x32::Block const& block) {
+      std::array<U, 4> rez {};
+      for (Size idx = 0; idx < 4; ++idx) {
+        rez[idx] = lower + (upper - lower) * utils::random::openUnit<U>(block[idx]);
+      }
+      return rez;
+    });
+  }
+
+  template <typename T>
+  auto normal(T& in, typename T::UnderlyingType mean, typename T::UnderlyingType deviation) const {
+    using U = typename T::UnderlyingType;
+    fill(in, [mean, deviation](utils::random::Philox4x32::Block const& block) {
+      auto rez = utils::random::standardNormal<U>(block);
+      for (auto& e : rez) {
+        e = mean + deviation * e;
+      }
+      return rez;
+    });
+  }
+
+private:
+  utils::random::Philox4x32 _generator;
+  uint64 _stream;
+};
+} // namespace impl
+
+//schemes constructed without an explicit seed draw one from this sequence; seeding it makes whole networks reproducible
+inline auto seedInitialization(uint64 seed) -> void { impl::initializationSeeds() = seed; }
+inline auto nextInitializationSeed() -> uint64 {
+  return utils::random::SplitMix64 {impl::initializationSeeds().fetch_add(1)}();
+}
+
 template <typename D> struct InitializationScheme {
+  InitializationScheme() : InitializationScheme(nextInitializationSeed()) {}
+  explicit InitializationScheme(uint64 seed, uint64 firstStream = 0) : _generator {seed}, _stream {firstStream} {}
+
+  //every initialized tensor gets its own stream of the generator
   template <typename In, typename... Params> auto operator()(In& in, Params... params) const {
-    std::random_device rd {};
-    static_cast<D const*>(this)->initialize(in, rd, params...);
+    static_cast<D const*>(this)->initialize(in, impl::TensorStream {_generator, _stream++}, params...);
   }
+
+private:
+  utils::random::Philox4x32 _generator;
+  mutable uint64 _stream;
 };
 
 struct NoInitialization : InitializationScheme<NoInitialization> {
-  template <typename In, typename... Params> auto initialize(In&, std::random_device&, Params...) const { /* empty */
+  using InitializationScheme<NoInitialization>::InitializationScheme;
+
+  template <typename In, typename... Params> auto initialize(In&, impl::TensorStream const&, Params...) const {
+    /* empty */
   }
 };
 
 template <typename = void> struct HeInitialization {};
 
 template <> struct HeInitialization<void> {
+  HeInitialization() = default;
+  explicit HeInitialization(uint64 seed) : _seed {seed} {}
+
   template <typename T, typename... Params> auto operator()(T&& in, Params... params) {
-    return HeInitialization<std::remove_cvref_t<T>> {}(std::forward<T>(in), params...);
+    return HeInitialization<std::remove_cvref_t<T>> {_seed, _stream++}(std::forward<T>(in), params...);
   }
+
+private:
+  uint64 _seed {nextInitializationSeed()};
+  uint64 _stream {0};
 };
 
 template <gabe::utils::concepts::DeepKernelType KernelArray> struct HeInitialization<KernelArray> :
     InitializationScheme<HeInitialization<KernelArray>> {
-  auto initialize(KernelArray& in, std::random_device& rd, Size depth) const {
+  using InitializationScheme<HeInitialization<KernelArray>>::InitializationScheme;
+
+  auto initialize(KernelArray& in, impl::TensorStream const& stream, Size depth) const {
     using KA = typename KernelArray::InnerLinearArray;
-    std::normal_distribution<typename KA::UnderlyingType> distribution(
-        0, 1.0 / std::sqrt(depth * KA::total_size() / KA::size()));
-    auto transformer = [&distribution, &rd](typename KA::UnderlyingType) { return distribution(rd); };
-    in.transform(transformer);
+    stream.normal(in, 0, 1.0 / std::sqrt(depth * KA::total_size() / KA::size()));
   }
 };
 
 template <gabe::utils::concepts::LinearMatrixType Matrix> struct HeInitialization<Matrix> :
     InitializationScheme<HeInitialization<Matrix>> {
-  auto initialize(Matrix& in, std::random_device& rd) const {
-    std::normal_distribution<typename Matrix::UnderlyingType> distribution(
-        0, 1.0 / std::sqrt(in.total_size() / in.size()));
-    auto transformer = [&distribution, &rd](typename Matrix::UnderlyingType) { return distribution(rd); };
-    in.transform(transformer);
+  using InitializationScheme<HeInitialization<Matrix>>::InitializationScheme;
+
+  auto initialize(Matrix& in, impl::TensorStream const& stream) const {
+    stream.normal(in, 0, 1.0 / std::sqrt(in.total_size() / in.size()));
   }
 };
 
 template <typename = void> struct XavierInitialization {};
 
 template <> struct XavierInitialization<void> {
+  XavierInitialization() = default;
+  explicit XavierInitialization(uint64 seed) : _seed {seed} {}
+
   template <typename T, typename... Params> auto operator()(T&& in, Params... params) {
-    return XavierInitialization<std::remove_cvref_t<T>> {}(std::forward<T>(in), params...);
+    return XavierInitialization<std::remove_cvref_t<T>> {_seed, _stream++}(std::forward<T>(in), params...);
   }
+
+private:
+  uint64 _seed {nextInitializationSeed()};
+  uint64 _stream {0};
 };
 
 template <gabe::utils::concepts::LinearMatrixType Matrix> struct XavierInitialization<Matrix> :
     InitializationScheme<XavierInitialization<Matrix>> {
-  auto initialize(Matrix& in, std::random_device& rd) const {
-    std::normal_distribution<typename Matrix::UnderlyingType> distribution(
-        0, std::sqrt(6.0 / (in.total_size() / in.size() + in.size())));
-    auto transformer = [&distribution, &rd](typename Matrix::UnderlyingType) { return distribution(rd); };
-    in.transform(transformer);
+  using InitializationScheme<XavierInitialization<Matrix>>::InitializationScheme;
+
+  auto initialize(Matrix& in, impl::TensorStream const& stream) const {
+    stream.normal(in, 0, std::sqrt(6.0 / (in.total_size() / in.size() + in.size())));
   }
 };
 
 template <int lb, int ub, int f = 1> struct UniformInitialization :
     InitializationScheme<UniformInitialization<lb, ub, f>> {
-  template <utils::concepts::LinearArrayType T> auto initialize(T& in, std::random_device& rd) const {
-    std::uniform_real_distribution distribution {
-        static_cast<typename T::UnderlyingType>(lb) / static_cast<typename T::UnderlyingType>(f),
-        static_cast<typename T::UnderlyingType>(ub) / static_cast<typename T::UnderlyingType>(f)};
-    auto transformer = [&distribution, &rd](typename T::UnderlyingType) { return distribution(rd); };
-    in.transform(transformer);
+  using InitializationScheme<UniformInitialization<lb, ub, f>>::InitializationScheme;
+
+  template <utils::concepts::LinearArrayType T> auto initialize(T& in, impl::TensorStream const& stream) const {
+    stream.uniform(in, static_cast<typename T::UnderlyingType>(lb) / static_cast<typename T::UnderlyingType>(f),
+                   static_cast<typename T::UnderlyingType>(ub) / static_cast<typename T::UnderlyingType>(f));
   }
 };
 } // namespace gabe::nn
@@ -8,8 +8,12 @@
 #include "engine/GameState.hpp"
 #include "multithreaded/runnable/Runnable.hpp"
 #include "multithreaded/synchronizer/Synchronizer.hpp"
+#include "replay/Recorder.hpp"
 #include <cstdio>
+#include <optional>
+#include <string_view>
 #include <thread>
+#include <utility>
 
 namespace gabe {
 class PositionReader : public Runnable<PositionReader> {
@@ -23,8 +27,23 @@ public:
 
   ~PositionReader() { fclose(_pIn); }
 
+  //position and orientation of a console line holding the output of getpos
+  static auto parseSetPos(std::string_view line) -> std::optional<std::pair<Position, Orientation>> {
+    constexpr auto setPosOffset = std::string_view {"setpos"}.length();
+    auto pos = line.find("setpos");
+    if (pos == std::string_view::npos) {
+      return std::nullopt;
+    }
+    auto stringStream = std::stringstream {std::string {line.substr(pos + setPosOffset)}};
+    Position position;
+    Orientation orientation;
+    std::string angleDelimiter;
+    stringStream >> position.x >> position.y >> position.z;
+    stringStream >> angleDelimiter >> orientation.x >> orientation.y >> orientation.z;
+    return std::pair {position, orientation};
+  }
+
   auto mainLoop() -> void {
-    constexpr auto setPosOffset = std::string("setpos").length();
     static char currentChar;
     static std::string currentString;
 
@@ -36,15 +55,14 @@ public:
     }
     fread(&currentChar, 1, 1, _pIn);
     if (currentChar == '\n') {
-      if (auto pos = currentString.find("setpos"); pos != std::string::npos) {
-        auto stringStream = std::stringstream {currentString.substr(pos + setPosOffset)};
-        Position position;
-        Orientation orientation;
-        std::string angleDelimiter;
-        stringStream >> position.x >> position.y >> position.z;
-        stringStream >> angleDelimiter >> orientation.x >> orientation.y >> orientation.z;
-        _gameState.set(GameState::Properties::POSITION, position);
-        _gameState.set(GameState::Properties::ORIENTATION, orientation);
+      if (auto parsed = parseSetPos(currentString); parsed.has_value()) {
+        replay::record(replay::Source::POSITION, currentString);
+        auto const& position = parsed->first;
+        auto const& orientation = parsed->second;
+        _gameState.publish([&position, &orientation](GameStateSnapshot& snapshot) {
+          snapshot.position = position;
+          snapshot.orientation = orientation;
+        });
         if (synchronizer.synchronizationRequired()) {
           synchronizer.handleSynchronization();
         }
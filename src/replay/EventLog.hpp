@@ -0,0 +1,77 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "event/EventSink.hpp"
+#include "utils/file/Exceptions.hpp"
+#include "utils/trace/Trace.hpp"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace gabe::replay {
+//event sink of a headless engine: events are solved against a recording backend, which runs on virtual time, and,
+//given a path, written one per line as "<ns since start> <event> <frame> <actions> <virtual duration in us>"
+class EventLog : public EventSink {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  EventLog() = default;
+  EventLog(EventLog const&) = delete;
+  EventLog(EventLog&&) noexcept = delete;
+
+  explicit EventLog(std::string const& filePath) noexcept(false) : _file {fopen(filePath.c_str(), "w"), &fclose} {
+    if (!_file) {
+      throw utils::exceptions::FileOpenException {filePath};
+    }
+  }
+
+  //stepped replays stamp events with the time of the release producing them instead of the time since the log opened
+  auto setElapsed(std::function<std::chrono::nanoseconds()>&& elapsed) -> void { _elapsed = std::move(elapsed); }
+
+  auto addEvent(AnyEvent&& event, uint64 flow = 0) -> void override {
+    if (isEmpty(event)) {
+      return;
+    }
+    utils::trace::Span span {eventName(event), utils::trace::Stage::SOLVE};
+    span.setFlow(flow);
+    auto const offset = _elapsed().count();
+    std::lock_guard lockGuard {_lock};
+    ++_counts[event.index()];
+    auto const virtualStart = _backend.now();
+    solve(event, _backend);
+    if (_file) {
+      fprintf(_file.get(), "%ld %s %lu %zu %ld\n", static_cast<long>(offset), eventName(event), flow,
+              _backend.performed().size(), static_cast<long>((_backend.now() - virtualStart).count()));
+    }
+    _backend.clear();
+  }
+
+  [[nodiscard]] auto count(Size eventIndex) const -> Size {
+    std::lock_guard lockGuard {_lock};
+    return _counts[eventIndex];
+  }
+
+  [[nodiscard]] auto total() const -> Size {
+    std::lock_guard lockGuard {_lock};
+    Size rez {};
+    for (auto count : _counts) {
+      rez += count;
+    }
+    return rez;
+  }
+
+private:
+  std::unique_ptr<FILE, decltype(&fclose)> _file {nullptr, &fclose};
+  std::function<std::chrono::nanoseconds()> _elapsed {[start = Clock::now()] { return Clock::now() - start; }};
+  std::array<Size, std::variant_size_v<AnyEvent>> _counts {};
+  RecordingBackend _backend {};
+  mutable std::mutex _lock {};
+};
+} // namespace gabe::replay
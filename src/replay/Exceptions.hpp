@@ -0,0 +1,31 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include <exception>
+#include <string>
+
+namespace gabe::replay::exceptions {
+class InvalidRecordingException : public std::exception {
+public:
+  explicit InvalidRecordingException(std::string const& filePath) :
+      _msg {"File " + filePath + " is not a valid recording"} {}
+
+  [[nodiscard]] char const* what() const noexcept override { return _msg.c_str(); }
+
+private:
+  std::string _msg;
+};
+
+class RecordingWriteException : public std::exception {
+public:
+  explicit RecordingWriteException(std::string const& filePath) : _msg {"Could not write to recording " + filePath} {}
+
+  [[nodiscard]] char const* what() const noexcept override { return _msg.c_str(); }
+
+private:
+  std::string _msg;
+};
+} // namespace gabe::replay::exceptions
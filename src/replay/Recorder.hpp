@@ -0,0 +1,174 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Exceptions.hpp"
+#include "types.hpp"
+#include "utils/file/Exceptions.hpp"
+#include "utils/file/MappedFile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+//Recordings hold every input the engine takes from the game, stamped with the time since the recording started.
+//The layout is a magic header followed by entries of {uint8 source, uint64 offset in ns, uint64 size, payload},
+//in native byte order; recordings are replayed on the machine type they were taken on
+namespace gabe::replay {
+enum class Source : uint8 { GAME_STATE, POSITION, FRAME };
+
+struct Entry {
+  Source source;
+  std::chrono::nanoseconds offset;
+  std::string_view payload;
+};
+
+namespace impl {
+constexpr std::string_view magic {"GABEREC1"};
+constexpr Size entryHeaderSize = sizeof(uint8) + 2 * sizeof(uint64);
+} // namespace impl
+
+//appends entries to a recording file; entries come from the server, position reader and capturing threads at once
+class Recorder {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  Recorder() = delete;
+  Recorder(Recorder const&) = delete;
+  Recorder(Recorder&&) noexcept = delete;
+
+  explicit Recorder(std::string const& filePath) noexcept(false) :
+      _file {fopen(filePath.c_str(), "wb"), &fclose}, _filePath {filePath} {
+    if (!_file) {
+      throw utils::exceptions::FileOpenException {filePath};
+    }
+    write(impl::magic.data(), impl::magic.size());
+  }
+
+  auto record(Source source, std::string_view payload) noexcept(false) -> void {
+    auto const offset = static_cast<uint64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count());
+    auto const size = static_cast<uint64>(payload.size());
+    std::lock_guard lockGuard {_lock};
+    write(&source, sizeof(source));
+    write(&offset, sizeof(offset));
+    write(&size, sizeof(size));
+    write(payload.data(), payload.size());
+  }
+
+  auto flush() noexcept(false) -> void {
+    std::lock_guard lockGuard {_lock};
+    if (fflush(_file.get()) != 0) {
+      throw exceptions::RecordingWriteException {_filePath};
+    }
+  }
+
+private:
+  //a short write leaves the recording truncated, which replays as if it ended there
+  auto write(void const* data, Size size) noexcept(false) -> void {
+    if (fwrite(data, 1, size, _file.get()) != size) {
+      throw exceptions::RecordingWriteException {_filePath};
+    }
+  }
+
+  std::unique_ptr<FILE, decltype(&fclose)> _file;
+  std::string _filePath;
+  Clock::time_point const _start {Clock::now()};
+  std::mutex _lock {};
+};
+
+namespace impl {
+inline auto activeRecorder() -> std::atomic<Recorder*>& {
+  static std::atomic<Recorder*> recorder {nullptr};
+  return recorder;
+}
+} // namespace impl
+
+//process wide recording, so the input sources don't need to be handed a recorder; recording until the process exits
+inline auto startRecording(std::string const& filePath) noexcept(false) -> void {
+  static std::unique_ptr<Recorder> recorder {};
+  recorder = std::make_unique<Recorder>(filePath);
+  impl::activeRecorder().store(recorder.get(), std::memory_order_release);
+}
+
+[[nodiscard]] inline auto recording() -> bool {
+  return impl::activeRecorder().load(std::memory_order_relaxed) != nullptr;
+}
+
+inline auto record(Source source, std::string_view payload) noexcept(false) -> void {
+  if (auto* recorder = impl::activeRecorder().load(std::memory_order_acquire); recorder != nullptr) {
+    recorder->record(source, payload);
+  }
+}
+
+inline auto flushRecording() noexcept(false) -> void {
+  if (auto* recorder = impl::activeRecorder().load(std::memory_order_acquire); recorder != nullptr) {
+    recorder->flush();
+  }
+}
+
+//read side of a recording; entries point into the mapping and are valid while the recording lives
+class Recording {
+public:
+  Recording() = delete;
+  Recording(Recording const&) = delete;
+  Recording(Recording&&) noexcept = default;
+
+  explicit Recording(std::string const& filePath) noexcept(false) : _file {filePath} {
+    if (!_file.text().starts_with(impl::magic)) {
+      throw exceptions::InvalidRecordingException {filePath};
+    }
+  }
+
+  class Iterator {
+  public:
+    Iterator(std::string_view remaining) : _remaining {remaining} {}
+
+    auto operator*() const -> Entry {
+      Entry entry {};
+      uint64 offset;
+      uint64 size;
+      std::memcpy(&entry.source, _remaining.data(), sizeof(uint8));
+      std::memcpy(&offset, _remaining.data() + sizeof(uint8), sizeof(uint64));
+      std::memcpy(&size, _remaining.data() + sizeof(uint8) + sizeof(uint64), sizeof(uint64));
+      entry.offset = std::chrono::nanoseconds {offset};
+      entry.payload = _remaining.substr(impl::entryHeaderSize, size);
+      return entry;
+    }
+
+    auto operator++() -> Iterator& {
+      _remaining.remove_prefix(std::min(impl::entryHeaderSize + (**this).payload.size(), _remaining.size()));
+      return *this;
+    }
+
+    //a truncated last entry, left by a process that was killed while recording, ends the recording
+    auto operator==(std::default_sentinel_t) const -> bool { return !complete(); }
+
+  private:
+    [[nodiscard]] auto complete() const -> bool {
+      if (_remaining.size() < impl::entryHeaderSize) {
+        return false;
+      }
+      uint64 size;
+      std::memcpy(&size, _remaining.data() + sizeof(uint8) + sizeof(uint64), sizeof(uint64));
+      return size <= _remaining.size() - impl::entryHeaderSize;
+    }
+
+    std::string_view _remaining;
+  };
+
+  [[nodiscard]] auto begin() const -> Iterator { return {_file.text().substr(impl::magic.size())}; }
+  [[nodiscard]] auto end() const -> std::default_sentinel_t { return {}; }
+
+private:
+  utils::file::MappedFile _file;
+};
+} // namespace gabe::replay
@@ -0,0 +1,125 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Recorder.hpp"
+#include "Stepping.hpp"
+#include "engine/GameState.hpp"
+#include "positionReader/PositionReader.hpp"
+#include "utils/logger/Logger.hpp"
+#include "utils/trace/Trace.hpp"
+#include <CDS/util/JSON>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+namespace gabe::replay {
+enum class Pace {
+  //entries are applied at the offsets they were recorded at
+  ORIGINAL,
+  //entries are applied back to back on the thread running the scheduler, which steps through their offsets instead
+  //of the steady clock; replays are deterministic and as fast as the trees allow, for tests and benchmarks
+  FAST
+};
+
+//feeds a recording into the game state in place of the integrator, the position reader and screen capturing
+class Replayer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  Replayer() = delete;
+  Replayer(Replayer const&) = delete;
+  Replayer(Replayer&&) noexcept = delete;
+
+  Replayer(GameState& state, Recording&& recording, Pace pace) :
+      _state {state}, _recording {std::move(recording)}, _pace {pace} {}
+
+  auto run() -> void {
+    _thread = std::jthread {[this](std::stop_token const& stopToken) { replay(stopToken); }};
+  }
+
+  //applies the whole recording on the calling thread, stepping the scheduler through it
+  auto replayStepped(Scheduler& scheduler) -> void {
+    _appliedCount.store(stepThrough(_recording, scheduler, [this](Entry const& entry) { apply(entry); }),
+                        std::memory_order_relaxed);
+    _finished.store(true, std::memory_order_release);
+  }
+
+  auto stop() -> void {
+    _thread.request_stop();
+    if (_thread.joinable()) {
+      _thread.join();
+    }
+  }
+
+  [[nodiscard]] auto pace() const -> Pace { return _pace; }
+  [[nodiscard]] auto finished() const -> bool { return _finished.load(std::memory_order_acquire); }
+  [[nodiscard]] auto appliedCount() const -> Size { return _appliedCount.load(std::memory_order_relaxed); }
+
+private:
+  auto replay(std::stop_token const& stopToken) -> void {
+    auto const start = Clock::now();
+    for (auto const entry : _recording) {
+      if (stopToken.stop_requested()) {
+        break;
+      }
+      if (_pace == Pace::ORIGINAL) {
+        std::this_thread::sleep_until(start + entry.offset);
+      }
+      apply(entry);
+      _appliedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    _finished.store(true, std::memory_order_release);
+  }
+
+  auto apply(Entry const& entry) -> void {
+    switch (entry.source) {
+      using enum Source;
+      case GAME_STATE: {
+        try {
+          auto jsonData = cds::json::parseJson(std::string {entry.payload});
+          _state.update(jsonData);
+        } catch (cds::Exception const& e) {
+          log("Skipping unparsable game state in recording", OpState::FAILURE);
+        }
+        break;
+      }
+      case POSITION: {
+        if (auto parsed = PositionReader::parseSetPos(entry.payload); parsed.has_value()) {
+          _state.publish([&parsed](GameStateSnapshot& snapshot) {
+            snapshot.position = parsed->first;
+            snapshot.orientation = parsed->second;
+          });
+        }
+        break;
+      }
+      case FRAME: {
+        applyFrame(entry.payload);
+        break;
+      }
+    }
+  }
+
+  //frames are published as if they were captured now, so detection latencies stay meaningful when replaying fast
+  auto applyFrame(std::string_view frame) -> void {
+    if (frame.size() != _state.frames.frameSize() || !_state.frames.beginCapture()) {
+      return;
+    }
+    utils::trace::Span span {"replayedFrame", utils::trace::Stage::CAPTURE};
+    std::memcpy(_state.frames.captureBuffer(), frame.data(), frame.size());
+    span.setFlow(_state.frames.publish(FrameRing::Clock::now()));
+  }
+
+  GameState& _state;
+  Recording _recording;
+  Pace _pace;
+  std::atomic<bool> _finished {false};
+  std::atomic<Size> _appliedCount {0};
+  std::jthread _thread {};
+};
+} // namespace gabe::replay
@@ -0,0 +1,30 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Recorder.hpp"
+#include "multithreaded/scheduler/Scheduler.hpp"
+#include "types.hpp"
+#include <chrono>
+
+namespace gabe::replay {
+//Replays a recording on the virtual clock of a scheduler, starting at its epoch: the scheduler steps to the timestamp
+//of every entry, the entry is applied, then the tasks it woke are stepped at the same time. Nothing waits on the
+//steady clock, so a recording ticks the same tasks against the same inputs however fast it is replayed
+//returns the number of entries applied
+template <typename Apply> auto stepThrough(Recording const& recording, Scheduler& scheduler, Apply&& apply) -> Size {
+  Scheduler::Clock::time_point const origin {};
+  scheduler.stepTo(origin);
+  Size rez = 0;
+  for (auto const entry : recording) {
+    auto const time = origin + std::chrono::duration_cast<Scheduler::Duration>(entry.offset);
+    scheduler.stepTo(time);
+    apply(entry);
+    scheduler.stepTo(time);
+    ++rez;
+  }
+  return rez;
+}
+} // namespace gabe::replay
@@ -12,6 +12,7 @@
 #include <list>
 #include <mutex>
 #include <netinet/in.h>
+#include <replay/Recorder.hpp>
 #include <socket/Socket.hpp>
 #include <thread/Thread.hpp>
 #include <unistd.h>
@@ -77,6 +78,7 @@ private:
       try {
         auto lg = std::lock_guard {myMutex};
         try {
+          replay::record(replay::Source::GAME_STATE, request.getBody());
           auto jsonData = cds::json::parseJson(request.getBody());
           threadParam->state.update(jsonData);
         } catch (cds::Exception const& e) {
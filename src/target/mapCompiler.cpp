@@ -0,0 +1,48 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include <engine/MapDescription.hpp>
+#include <iostream>
+#include <string_view>
+
+namespace {
+using namespace gabe;
+
+auto usage() -> int {
+  std::cout << "usage: mapCompiler <description> <navigation file> [--distance]\n"
+               "  compiles the text description of a map into the navigation file the engine loads\n"
+               "  --distance  route between zones over the shortest distance instead of the fewest zones\n";
+  return 1;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    return usage();
+  }
+
+  auto routeCost = Map::RouteCost::HOPS;
+  for (auto idx = 3; idx < argc; ++idx) {
+    if (std::string_view {argv[idx]} == "--distance") {
+      routeCost = Map::RouteCost::DISTANCE;
+    } else {
+      return usage();
+    }
+  }
+
+  try {
+    utils::file::MappedFile const description {argv[1]};
+    Map const map {parseMapDescription(description.text()), routeCost};
+    if (!map.save(argv[2])) {
+      std::cout << "Could not write " << argv[2] << '\n';
+      return 1;
+    }
+    std::cout << "Compiled " << map.zoneCount() << " zones and " << map.portalCount() << " portals into " << argv[2]
+              << '\n';
+    return 0;
+  } catch (std::exception const& e) {
+    std::cout << e.what() << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,71 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include <engine/Engine.hpp>
+#include <cctype>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+using namespace gabe;
+
+auto usage() -> int {
+  std::cout << "usage: replay <recording> [--fast] [--events <path>] [--seed <seed>]\n"
+               "  --fast    apply the recorded inputs back to back, stepping the trees through their recorded times\n"
+               "  --events  write every produced event to <path>\n"
+               "  --seed    seed for the decision trees, 0 by default\n";
+  return 1;
+}
+
+//the whole argument has to be a decimal number
+auto parseSeed(std::string const& argument) -> std::optional<uint64> {
+  try {
+    Size parsed {};
+    auto const seed = std::stoull(argument, &parsed);
+    if (parsed == argument.size() && std::isdigit(static_cast<unsigned char>(argument.front())) != 0) {
+      return seed;
+    }
+  } catch (std::logic_error const&) {
+    //stoull throws invalid_argument and out_of_range, both logic errors
+  }
+  return std::nullopt;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    return usage();
+  }
+
+  auto pace = replay::Pace::ORIGINAL;
+  std::string eventLogPath {};
+  uint64 seed {0};
+  for (auto idx = 2; idx < argc; ++idx) {
+    std::string_view const argument {argv[idx]};
+    if (argument == "--fast") {
+      pace = replay::Pace::FAST;
+    } else if (argument == "--events" && idx + 1 < argc) {
+      eventLogPath = argv[++idx];
+    } else if (argument == "--seed" && idx + 1 < argc) {
+      auto const parsed = parseSeed(argv[++idx]);
+      if (!parsed) {
+        return usage();
+      }
+      seed = *parsed;
+    } else {
+      return usage();
+    }
+  }
+
+  try {
+    Engine engine {"../", replay::Recording {argv[1]}, pace, eventLogPath, seed};
+    return engine.run();
+  } catch (std::exception const& e) {
+    std::cout << e.what() << '\n';
+    return 1;
+  }
+}
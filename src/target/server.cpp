@@ -10,7 +10,7 @@ using namespace gabe::server;
 
 int main() {
   try {
-    gabe::GameState state;
+    gabe::GameState state {GABE_MAPS_FOLDER "de_dust2.nav"};
     Server server {state};
     while (true) {
       server.getClient();
@@ -4,17 +4,156 @@
 
 #pragma once
 
+#include "utils/concepts/Concepts.hpp"
+#include "utils/math/linearArray/LinearArray.hpp"
 #include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdio>
 #include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace gabe::utils::data {
 
+namespace impl {
+using math::linearArray::flatView;
+
+inline auto defaultThreadCount() -> Size { return std::max(1u, std::thread::hardware_concurrency()); }
+
+//splits [0, count) in contiguous chunks, one per thread; work receives (chunkIdx, begin, end)
+template <typename W> auto parallelFor(Size count, Size threadCount, W&& work) -> void {
+  threadCount = std::clamp<Size>(threadCount, 1, std::max<Size>(count, 1));
+  if (threadCount == 1) {
+    work(0, 0, count);
+    return;
+  }
+  std::vector<std::jthread> threads {};
+  threads.reserve(threadCount);
+  for (Size idx = 0; idx < threadCount; ++idx) {
+    threads.emplace_back(work, idx, count * idx / threadCount, count * (idx + 1) / threadCount);
+  }
+}
+} // namespace impl
+
 template <concepts::LinearArrayType DataPointType> struct ImageDataPoint {
   DataPointType data {};
   typename DataPointType::UnderlyingType label {};
 };
 
+//Per-element minimum and reciprocal range of a data set; normalizing an input becomes (x - min) * scale.
+//Elements which never vary get a scale of 0 and normalize to 0.
+template <concepts::LinearArrayType T> class NormalizationStatistics {
+public:
+  using UnderlyingType = typename T::UnderlyingType;
+  static_assert(std::floating_point<UnderlyingType>, "Normalization requires floating point data");
+
+  NormalizationStatistics() = default;
+  NormalizationStatistics(NormalizationStatistics const&) = default;
+  NormalizationStatistics(NormalizationStatistics&&) noexcept = default;
+  auto operator=(NormalizationStatistics const&) -> NormalizationStatistics& = default;
+  auto operator=(NormalizationStatistics&&) noexcept -> NormalizationStatistics& = default;
+
+  NormalizationStatistics(T const& min, T const& max) : _min {min} {
+    auto lo = impl::flatView(_min);
+    auto hi = impl::flatView(max);
+    auto scale = impl::flatView(_scale);
+    for (Size idx = 0; idx < T::total_size(); ++idx) {
+      auto const range = hi[idx] - lo[idx];
+      scale[idx] = range == 0 ? 0 : static_cast<UnderlyingType>(1) / range;
+    }
+  }
+
+  //two-stage reduction: every thread folds a contiguous chunk of samples into its own min/max pair,
+  //the partial results are then folded together
+  static auto compute(std::span<ImageDataPoint<T> const> data, Size threadCount = impl::defaultThreadCount())
+      -> NormalizationStatistics {
+    assert(!data.empty() && "Cannot compute normalization statistics of an empty data set");
+    threadCount = std::clamp<Size>(threadCount, 1, data.size());
+    std::vector<T> partialMin(threadCount, data[0].data);
+    std::vector<T> partialMax(threadCount, data[0].data);
+
+    impl::parallelFor(data.size(), threadCount, [&data, &partialMin, &partialMax](Size chunk, Size begin, Size end) {
+      auto lo = impl::flatView(partialMin[chunk]);
+      auto hi = impl::flatView(partialMax[chunk]);
+      for (auto idx = begin; idx < end; ++idx) {
+        fold(lo, hi, impl::flatView(data[idx].data));
+      }
+    });
+
+    auto lo = impl::flatView(partialMin[0]);
+    auto hi = impl::flatView(partialMax[0]);
+    for (Size chunk = 1; chunk < threadCount; ++chunk) {
+      fold(lo, hi, impl::flatView(std::as_const(partialMin[chunk])));
+      fold(lo, hi, impl::flatView(std::as_const(partialMax[chunk])));
+    }
+    return NormalizationStatistics {partialMin[0], partialMax[0]};
+  }
+
+  auto apply(T& data) const -> void {
+    auto values = impl::flatView(data);
+    auto lo = impl::flatView(_min);
+    auto scale = impl::flatView(_scale);
+    for (Size idx = 0; idx < T::total_size(); ++idx) {
+      values[idx] = (values[idx] - lo[idx]) * scale[idx];
+    }
+  }
+
+  auto apply(std::span<ImageDataPoint<T>> data, Size threadCount = impl::defaultThreadCount()) const -> void {
+    impl::parallelFor(data.size(), threadCount, [this, &data](Size, Size begin, Size end) {
+      for (auto idx = begin; idx < end; ++idx) {
+        apply(data[idx].data);
+      }
+    });
+  }
+
+  [[nodiscard]] auto const& min() const { return _min; }
+  [[nodiscard]] auto const& scale() const { return _scale; }
+
+  auto serialize(std::string const& outFilePath) const {
+    FILE* outFile = fopen(outFilePath.c_str(), "w");
+    serialize(outFile);
+    fclose(outFile);
+  }
+
+  auto serialize(FILE* outFile) const {
+    _min.serialize(outFile);
+    _scale.serialize(outFile);
+  }
+
+  static auto deserialize(std::string const& inFilePath) {
+    FILE* inFile = fopen(inFilePath.c_str(), "r");
+    auto rez = deserialize(inFile);
+    fclose(inFile);
+    return rez;
+  }
+
+  static auto deserialize(FILE* inFile) -> NormalizationStatistics {
+    NormalizationStatistics result {};
+    result._min = T::deserialize(inFile);
+    result._scale = T::deserialize(inFile);
+    return result;
+  }
+
+private:
+  template <typename Lo, typename Hi, typename V> static auto fold(Lo lo, Hi hi, V values) -> void {
+    //branch-free selects so the compiler can lower both loops to packed min/max instructions
+    for (Size idx = 0; idx < values.size(); ++idx) {
+      lo[idx] = values[idx] < lo[idx] ? values[idx] : lo[idx];
+    }
+    for (Size idx = 0; idx < values.size(); ++idx) {
+      hi[idx] = values[idx] > hi[idx] ? values[idx] : hi[idx];
+    }
+  }
+
+  T _min {};
+  T _scale {};
+};
+
 template <concepts::LinearArrayType T> class ImageDataSet {
 
 public:
@@ -23,20 +162,14 @@ public:
   ImageDataSet(ImageDataSet&&) noexcept = default;
   explicit ImageDataSet(std::vector<ImageDataPoint<T>> const& data) : _data(data) {}
 
-  auto normalize() {
-
-    auto min = _data[0].data;
-    auto max = _data[0].data;
-    for (auto const& e : _data) {
-      min = min.maximize(e.data, std::less<typename T::UnderlyingType> {});
-      max = max.maximize(e.data, std::greater<typename T::UnderlyingType> {});
-    }
-    auto diff = max - min;
-
-    auto normalizer = [min, diff](ImageDataPoint<T>& arr) { arr.data = (arr.data - min) / diff; };
-    std::ranges::for_each(_data, normalizer);
+  auto normalize() -> NormalizationStatistics<T> {
+    auto statistics = NormalizationStatistics<T>::compute(_data);
+    statistics.apply(_data);
+    return statistics;
   }
 
+  auto normalize(NormalizationStatistics<T> const& statistics) -> void { statistics.apply(_data); }
+
   auto const& data() const { return _data; }
   auto& data() { return _data; }
 
@@ -0,0 +1,32 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include <exception>
+#include <string>
+#include <string_view>
+
+namespace gabe::utils::exceptions {
+class StratificationException : public std::exception {
+public:
+  StratificationException() : _msg {"Stratified sampling requires a key extractor for the data points"} {}
+
+  [[nodiscard]] char const* what() const noexcept override { return _msg.c_str(); }
+
+private:
+  std::string _msg;
+};
+
+class MalformedFieldException : public std::exception {
+public:
+  explicit MalformedFieldException(std::string_view field) :
+      _msg {"Malformed numeric field \"" + std::string {field} + "\" in delimiter separated file"} {}
+
+  [[nodiscard]] char const* what() const noexcept override { return _msg.c_str(); }
+
+private:
+  std::string _msg;
+};
+} // namespace gabe::utils::exceptions
@@ -7,14 +7,20 @@
 #include "types.hpp"
 #include "utils/concepts/Concepts.hpp"
 #include "utils/data/Data.hpp"
+#include "utils/data/Exceptions.hpp"
+#include "utils/file/MappedFile.hpp"
 #include "utils/math/function/Function.hpp"
 #include <bitset>
+#include <charconv>
 #include <cstdio>
 #include <cstring>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <jpeglib.h>
 #include <sstream>
+#include <string_view>
+#include <thread>
 
 namespace gabe::utils::data {
 
@@ -183,6 +189,139 @@ template <concepts::DeepLinearMatrixType K> auto loadCS2Labels(std::string const
 
   return rez;
 }
+
+//decodes jpegs into one reusable interleaved byte buffer
+class JpegDecoder {
+public:
+  JpegDecoder() {
+    _cinfo.err = jpeg_std_error(&_jerr);
+    jpeg_create_decompress(&_cinfo);
+  }
+
+  JpegDecoder(JpegDecoder const&) = delete;
+  JpegDecoder(JpegDecoder&&) noexcept = delete;
+  ~JpegDecoder() { jpeg_destroy_decompress(&_cinfo); }
+
+  auto decode(std::string const& filePath) -> std::span<uint8 const> {
+    FILE* in = fopen(filePath.c_str(), "rb");
+    if (in == nullptr) {
+      throw exceptions::FileOpenException {filePath};
+    }
+
+    jpeg_stdio_src(&_cinfo, in);
+    jpeg_read_header(&_cinfo, TRUE);
+    jpeg_start_decompress(&_cinfo);
+
+    _width = _cinfo.output_width;
+    _height = _cinfo.output_height;
+    _channels = _cinfo.output_components;
+    _buffer.resize(_width * _height * _channels);
+
+    while (_cinfo.output_scanline < _cinfo.output_height) {
+      unsigned char* row_pointer = &_buffer[_cinfo.output_scanline * _width * _channels];
+      jpeg_read_scanlines(&_cinfo, &row_pointer, 1);
+    }
+
+    jpeg_finish_decompress(&_cinfo);
+    fclose(in);
+    return _buffer;
+  }
+
+  [[nodiscard]] auto width() const -> Size { return _width; }
+  [[nodiscard]] auto height() const -> Size { return _height; }
+  [[nodiscard]] auto channels() const -> Size { return _channels; }
+
+private:
+  struct jpeg_decompress_struct _cinfo {};
+  struct jpeg_error_mgr _jerr {};
+  std::vector<uint8> _buffer {};
+  Size _width {0};
+  Size _height {0};
+  Size _channels {0};
+};
+
+struct DigitLabel {
+  Size label;
+  Size widthOffset;
+  Size heightOffset;
+};
+
+//every line of a digit label file is "label widthOffset heightOffset"
+inline auto loadDigitLabels(std::string const& filePath) -> std::vector<DigitLabel> {
+  std::vector<DigitLabel> rez {};
+  file::MappedFile mappedFile {filePath};
+  auto const* it = mappedFile.text().data();
+  auto const* end = it + mappedFile.size();
+
+  auto next = [&it, end](Size& value) {
+    while (it != end && (*it == ' ' || *it == '\r' || *it == '\n')) {
+      ++it;
+    }
+    auto [ptr, errc] = std::from_chars(it, end, value);
+    it = ptr;
+    return errc == std::errc {};
+  };
+
+  DigitLabel label {};
+  while (next(label.label) && next(label.widthOffset) && next(label.heightOffset)) {
+    rez.push_back(label);
+  }
+  return rez;
+}
+
+//the whole field must be a number, give or take surrounding spaces and a leading plus sign
+template <typename T> auto parseField(std::string_view field) noexcept(false) -> T {
+  while (!field.empty() && (field.front() == ' ' || field.front() == '+')) {
+    field.remove_prefix(1);
+  }
+  while (!field.empty() && field.back() == ' ') {
+    field.remove_suffix(1);
+  }
+  T value {};
+  auto const last = field.data() + field.size();
+  auto const [ptr, errc] = std::from_chars(field.data(), last, value);
+  if (errc != std::errc {} || ptr != last) {
+    throw exceptions::MalformedFieldException {field};
+  }
+  return value;
+}
+
+//parses whole lines in place; fields split on the delimiter, empty ones skipped, the last one is the label
+template <concepts::LinearArrayType R> auto parseDelimSeparatedLines(std::string_view text, char delim,
+                                                                      std::vector<ImageDataPoint<R>>& out) -> void {
+  using UnderlyingType = typename R::UnderlyingType;
+  out.reserve(out.size() + std::count(text.begin(), text.end(), '\n') + 1);
+
+  while (!text.empty()) {
+    auto lineEnd = text.find('\n');
+    auto line = text.substr(0, lineEnd);
+    text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+
+    auto lastDelimIdx = line.find_last_of(delim);
+    if (lastDelimIdx == std::string_view::npos) {
+      continue;
+    }
+
+    std::array<UnderlyingType, R::total_size()> data {};
+    auto fields = line.substr(0, lastDelimIdx);
+    Size idx = 0;
+    while (!fields.empty()) {
+      auto fieldEnd = fields.find(delim);
+      auto field = fields.substr(0, fieldEnd);
+      fields.remove_prefix(fieldEnd == std::string_view::npos ? fields.size() : fieldEnd + 1);
+      if (field.empty()) {
+        continue;
+      }
+      assert(idx < data.size() && "Line holds more fields than the container");
+      data[idx++] = parseField<UnderlyingType>(field);
+    }
+
+    out.emplace_back(R {data}, parseField<UnderlyingType>(line.substr(lastDelimIdx + 1)));
+  }
+}
 } // namespace impl
 
 enum class MNISTDataSetType { TEST, TRAIN };
@@ -214,40 +353,57 @@ template <concepts::DeepLinearMatrixType I, Size widthTrunc = I::InnerLinearArra
           Size heightTrunc = I::InnerLinearArray::size(),
           concepts::DeepLinearMatrixType FullJpgArr = math::LinearArray<typename I::UnderlyingType, 3, 25, 335>>
 auto loadCoordDigitsImages(std::string const& folderPath, int imgCount) {
-  ImageDataSet<I> images {};
-  I truncatedImage {};
+  using UnderlyingType = typename I::UnderlyingType;
+  static constexpr Size channelCount = FullJpgArr::size();
+  static constexpr Size fullHeight = FullJpgArr::InnerLinearArray::size();
+  static constexpr Size fullWidth = FullJpgArr::InnerLinearArray::InnerLinearArray::size();
+  static_assert(I::size() == channelCount, "Crops and source images should have the same number of channels");
+  static_assert(widthTrunc == I::InnerLinearArray::InnerLinearArray::size(), "Crop width should match the container");
+  static_assert(heightTrunc == I::InnerLinearArray::size(), "Crop height should match the container");
 
   std::string imgDirectory {folderPath + "/images/"};
   std::string labelDirectory {folderPath + "/labels/"};
 
+  std::vector<std::vector<impl::DigitLabel>> labels(imgCount);
+  Size labelCount = 0;
   for (auto idx = 0; idx < imgCount; ++idx) {
-    auto fullJpg = impl::loadJPEG<FullJpgArr>(imgDirectory + "image.jpg" + std::to_string(idx));
-    std::ifstream labelsIn {(labelDirectory + std::to_string(idx) + ".txt").c_str()};
-    auto* pLine = new char[32];
-    while (labelsIn.getline(pLine, 32)) {
-      std::string labelLine {pLine};
-      auto range = std::views::split(labelLine, ' ');
-      auto it = range.begin();
-
-      Size label;
-      Size widthOffset;
-      Size heightOffset;
-      label = std::strtol((*it).data(), nullptr, 10);
-      ++it;
-      widthOffset = std::strtol((*it).data(), nullptr, 10);
-      ++it;
-      heightOffset = std::strtol((*it).data(), nullptr, 10);
-      for (auto channel = 0; channel < 3; ++channel) {
-        for (auto cIdx = widthOffset; cIdx < widthTrunc + widthOffset; ++cIdx) {
-          for (auto lIdx = heightOffset; lIdx < heightTrunc + heightOffset; ++lIdx) {
-            truncatedImage[channel][lIdx - heightOffset][cIdx - widthOffset] = fullJpg[channel][lIdx][cIdx];
-          }
-        }
+    labels[idx] = impl::loadDigitLabels(labelDirectory + std::to_string(idx) + ".txt");
+    labelCount += labels[idx].size();
+  }
+
+  ImageDataSet<I> images {};
+  images.data().reserve(labelCount);
+
+  impl::JpegDecoder decoder {};
+  std::vector<UnderlyingType> planarImage(channelCount * fullHeight * fullWidth);
+  for (auto idx = 0; idx < imgCount; ++idx) {
+    if (labels[idx].empty()) {
+      continue;
+    }
+
+    auto pixels = decoder.decode(imgDirectory + "image.jpg" + std::to_string(idx));
+    assert(decoder.width() == fullWidth && decoder.height() == fullHeight && decoder.channels() == channelCount
+           && "Decoded image should match the dimensions of the full image container");
+    for (Size pixelIdx = 0; pixelIdx < fullHeight * fullWidth; ++pixelIdx) {
+      for (Size channel = 0; channel < channelCount; ++channel) {
+        planarImage[channel * fullHeight * fullWidth + pixelIdx] =
+            static_cast<UnderlyingType>(pixels[pixelIdx * channelCount + channel]);
       }
+    }
 
-      images.data().emplace_back(truncatedImage, label);
+    for (auto const& [label, widthOffset, heightOffset] : labels[idx]) {
+      assert(widthOffset + widthTrunc <= fullWidth && heightOffset + heightTrunc <= fullHeight
+             && "Labelled crop exceeds the bounds of the image");
+      auto& point = images.data().emplace_back(I {}, static_cast<UnderlyingType>(label));
+      auto crop = impl::flatView(point.data);
+      for (Size channel = 0; channel < channelCount; ++channel) {
+        for (Size lIdx = 0; lIdx < heightTrunc; ++lIdx) {
+          std::memcpy(crop.data() + (channel * heightTrunc + lIdx) * widthTrunc,
+                      planarImage.data() + (channel * fullHeight + heightOffset + lIdx) * fullWidth + widthOffset,
+                      widthTrunc * sizeof(UnderlyingType));
+        }
+      }
     }
-    delete[] pLine;
   }
   return images;
 }
@@ -274,38 +430,58 @@ template <concepts::DeepLinearMatrixType I> auto loadCS2Images(std::string const
   return images;
 }
 
-template <concepts::LinearArrayType R> auto loadDelimSeparatedFile(std::string const& filePath, char delim = ',')
-    -> ImageDataSet<R> {
-  ImageDataSet<R> rezVector;
-
-  std::ifstream in {filePath};
-  auto* linePtr = new char[1024];
-  auto* wordPtr = new char[16];
-
-  while (in.getline(linePtr, 1024)) {
-    std::array<typename R::UnderlyingType, R().size()> data;
-
-    std::string line {linePtr};
-    auto lastDelimIdx = line.find_last_of(delim);
-    auto label = utils::math::StringToIntegral<typename R::UnderlyingType>()(line.substr(lastDelimIdx + 1));
+//the file is mapped and split at line boundaries in threadCount chunks, parsed concurrently and joined in file order
+template <concepts::LinearArrayType R>
+auto loadDelimSeparatedFile(std::string const& filePath, char delim = ',', Size threadCount = 1) -> ImageDataSet<R> {
+  file::MappedFile mappedFile {filePath};
+  auto text = mappedFile.text();
+
+  std::vector<std::string_view> chunks {};
+  threadCount = std::max<Size>(threadCount, 1);
+  for (Size begin = 0, idx = 0; begin < text.size(); ++idx) {
+    auto end = idx + 1 >= threadCount ? text.size() : std::max(begin, text.size() * (idx + 1) / threadCount);
+    end = end >= text.size() ? text.size() : text.find('\n', end);
+    end = end == std::string_view::npos ? text.size() : end + 1;
+    chunks.push_back(text.substr(begin, end - begin));
+    begin = end;
+  }
 
-    std::stringstream lineString {line.substr(0, lastDelimIdx)};
+  ImageDataSet<R> rezVector;
+  if (chunks.size() <= 1) {
+    impl::parseDelimSeparatedLines<R>(text, delim, rezVector.data());
+    return rezVector;
+  }
 
-    Size idx = 0;
-    while (lineString.getline(wordPtr, 16, delim)) {
-      std::string word {wordPtr};
-      if (word.empty()) {
-        continue;
-      }
-      data[idx++] = utils::math::StringToIntegral<typename R::UnderlyingType>()(word);
+  std::vector<std::vector<ImageDataPoint<R>>> parsedChunks(chunks.size());
+  std::vector<std::exception_ptr> failures(chunks.size());
+  {
+    std::vector<std::jthread> threads {};
+    threads.reserve(chunks.size());
+    for (Size idx = 0; idx < chunks.size(); ++idx) {
+      threads.emplace_back([&chunks, &parsedChunks, &failures, delim, idx] {
+        try {
+          impl::parseDelimSeparatedLines<R>(chunks[idx], delim, parsedChunks[idx]);
+        } catch (...) {
+          failures[idx] = std::current_exception();
+        }
+      });
+    }
+  }
+  //the first malformed chunk in file order is reported, as when parsing on a single thread
+  for (auto const& failure : failures) {
+    if (failure) {
+      std::rethrow_exception(failure);
     }
-
-    rezVector.data().emplace_back(R {data}, label);
   }
 
-  delete[] linePtr;
-  delete[] wordPtr;
-
+  Size totalSize = 0;
+  for (auto const& chunk : parsedChunks) {
+    totalSize += chunk.size();
+  }
+  rezVector.data().reserve(totalSize);
+  for (auto& chunk : parsedChunks) {
+    rezVector.data().insert(rezVector.data().end(), chunk.begin(), chunk.end());
+  }
   return rezVector;
 }
 } // namespace gabe::utils::data
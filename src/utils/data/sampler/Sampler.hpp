@@ -0,0 +1,153 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "utils/data/Exceptions.hpp"
+#include "utils/random/Random.hpp"
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gabe::utils::data {
+
+enum class SamplingOrder { SEQUENTIAL, SHUFFLED, STRATIFIED };
+
+namespace impl {
+struct LabelKey {
+  template <typename DataPoint>
+    requires requires(DataPoint const& dataPoint) { dataPoint.label; }
+  auto operator()(DataPoint const& dataPoint) const {
+    return dataPoint.label;
+  }
+};
+} // namespace impl
+
+//Walks a data set through a permutation of its indices; the samples themselves are never moved or copied.
+//The only storage kept is O(n) 32-bit indices (twice that for stratified order).
+template <typename DataSet> class BatchSampler {
+public:
+  BatchSampler() = delete;
+  BatchSampler(BatchSampler const&) = default;
+  BatchSampler(BatchSampler&&) noexcept = default;
+
+  //stratified order throws StratificationException unless keyExtractor can be called on the data points
+  template <typename KeyExtractor = impl::LabelKey>
+  BatchSampler(DataSet const& dataSet, Size batchSize, SamplingOrder order = SamplingOrder::SHUFFLED,
+               uint64 seed = random::defaultSeed, KeyExtractor&& keyExtractor = {}) noexcept(false) :
+      _batchSize {batchSize}, _order {order}, _seed {seed}, _indices(dataSet.data().size()) {
+    assert(batchSize > 0 && "Batch size must be positive");
+    assert(dataSet.data().size() <= std::numeric_limits<uint32>::max() && "Data set too large for 32-bit indices");
+    std::iota(_indices.begin(), _indices.end(), 0u);
+
+    if (_order == SamplingOrder::STRATIFIED) {
+      using DataPoint = typename std::remove_cvref_t<decltype(dataSet.data())>::value_type;
+      if constexpr (std::invocable<KeyExtractor, DataPoint const&>) {
+        buildStrata(dataSet, std::forward<KeyExtractor>(keyExtractor));
+      } else {
+        throw exceptions::StratificationException {};
+      }
+    }
+    reshuffle(0);
+  }
+
+  //rebuilds the permutation for the given epoch; each epoch's order depends only on the seed and the epoch index
+  auto reshuffle(Size epoch) -> void {
+    random::Xoshiro256 generator {random::SplitMix64 {_seed + epoch}()};
+    switch (_order) {
+      using enum SamplingOrder;
+      case SEQUENTIAL: {
+        break;
+      }
+      case SHUFFLED: {
+        std::iota(_indices.begin(), _indices.end(), 0u);
+        random::shuffle(_indices.begin(), _indices.end(), generator);
+        break;
+      }
+      case STRATIFIED: {
+        stratifiedShuffle(generator);
+        break;
+      }
+    }
+  }
+
+  [[nodiscard]] auto size() const -> Size { return _indices.size(); }
+  [[nodiscard]] auto batchSize() const -> Size { return _batchSize; }
+  [[nodiscard]] auto batchCount() const -> Size { return (_indices.size() + _batchSize - 1) / _batchSize; }
+  [[nodiscard]] auto indices() const -> std::span<uint32 const> { return _indices; }
+
+  [[nodiscard]] auto batch(Size idx) const -> std::span<uint32 const> {
+    auto const begin = idx * _batchSize;
+    return indices().subspan(begin, std::min(_batchSize, _indices.size() - begin));
+  }
+
+private:
+  template <typename KeyExtractor> auto buildStrata(DataSet const& dataSet, KeyExtractor&& keyExtractor) -> void {
+    auto const& data = dataSet.data();
+    std::ranges::stable_sort(_indices, std::less {},
+                             [&data, &keyExtractor](uint32 idx) { return std::invoke(keyExtractor, data[idx]); });
+
+    _strataOffsets.push_back(0);
+    for (Size idx = 1; idx < _indices.size(); ++idx) {
+      if (std::invoke(keyExtractor, data[_indices[idx]]) != std::invoke(keyExtractor, data[_indices[idx - 1]])) {
+        _strataOffsets.push_back(static_cast<uint32>(idx));
+      }
+    }
+    _strataOffsets.push_back(static_cast<uint32>(_indices.size()));
+    _strata = _indices;
+  }
+
+  //shuffles inside every stratum, then merges the strata so that every window of the output holds
+  //each class in proportion to its share of the data set
+  auto stratifiedShuffle(random::Xoshiro256& generator) -> void {
+    if (_indices.empty()) {
+      return;
+    }
+
+    auto const strataCount = _strataOffsets.size() - 1;
+    std::vector<uint64> cursors(strataCount);
+    for (Size stratum = 0; stratum < strataCount; ++stratum) {
+      auto const first = _strata.begin() + _strataOffsets[stratum];
+      auto const last = _strata.begin() + _strataOffsets[stratum + 1];
+      std::sort(first, last);
+      random::shuffle(first, last, generator);
+    }
+
+    //element j of a stratum of size n sits at relative position (2j + 1) / 2n; pick the smallest at every step
+    for (auto& target : _indices) {
+      Size best = strataCount;
+      for (Size stratum = 0; stratum < strataCount; ++stratum) {
+        uint64 const count = _strataOffsets[stratum + 1] - _strataOffsets[stratum];
+        if (cursors[stratum] == count) {
+          continue;
+        }
+        if (best == strataCount) {
+          best = stratum;
+          continue;
+        }
+        uint64 const bestCount = _strataOffsets[best + 1] - _strataOffsets[best];
+        if ((2 * cursors[stratum] + 1) * bestCount < (2 * cursors[best] + 1) * count) {
+          best = stratum;
+        }
+      }
+      target = _strata[_strataOffsets[best] + cursors[best]++];
+    }
+  }
+
+  Size _batchSize {};
+  SamplingOrder _order {};
+  uint64 _seed {};
+  std::vector<uint32> _indices {};
+  std::vector<uint32> _strata {};
+  std::vector<uint32> _strataOffsets {};
+};
+
+} // namespace gabe::utils::data
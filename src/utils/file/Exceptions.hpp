@@ -0,0 +1,30 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include <exception>
+#include <string>
+
+namespace gabe::utils::exceptions {
+class FileOpenException : public std::exception {
+public:
+  explicit FileOpenException(std::string const& filePath) : _msg {"Could not open file " + filePath} {}
+
+  [[nodiscard]] char const* what() const noexcept override { return _msg.c_str(); }
+
+private:
+  std::string _msg;
+};
+
+class FileMapException : public std::exception {
+public:
+  explicit FileMapException(std::string const& filePath) : _msg {"Could not map file " + filePath} {}
+
+  [[nodiscard]] char const* what() const noexcept override { return _msg.c_str(); }
+
+private:
+  std::string _msg;
+};
+} // namespace gabe::utils::exceptions
@@ -0,0 +1,75 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Exceptions.hpp"
+#include "types.hpp"
+#include <fcntl.h>
+#include <span>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace gabe::utils::file {
+//read-only memory mapping of a whole file; the mapping lives as long as the object
+class MappedFile {
+public:
+  MappedFile() = delete;
+  MappedFile(MappedFile const&) = delete;
+  MappedFile(MappedFile&& other) noexcept :
+      _data {std::exchange(other._data, nullptr)}, _size {std::exchange(other._size, 0)} {}
+
+  explicit MappedFile(std::string const& filePath) {
+    auto fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw exceptions::FileOpenException {filePath};
+    }
+
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) < 0) {
+      close(fd);
+      throw exceptions::FileOpenException {filePath};
+    }
+
+    _size = static_cast<Size>(fileStat.st_size);
+    if (_size != 0) {
+      auto* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        close(fd);
+        throw exceptions::FileMapException {filePath};
+      }
+      _data = static_cast<char const*>(mapping);
+      madvise(mapping, _size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+  }
+
+  ~MappedFile() {
+    if (_data != nullptr) {
+      munmap(const_cast<char*>(_data), _size);
+    }
+  }
+
+  auto operator=(MappedFile const&) -> MappedFile& = delete;
+  auto operator=(MappedFile&& other) noexcept -> MappedFile& {
+    std::swap(_data, other._data);
+    std::swap(_size, other._size);
+    return *this;
+  }
+
+  [[nodiscard]] auto size() const -> Size { return _size; }
+  [[nodiscard]] auto text() const -> std::string_view { return {_data, _size}; }
+  [[nodiscard]] auto bytes() const -> std::span<std::byte const> {
+    return {reinterpret_cast<std::byte const*>(_data), _size};
+  }
+
+private:
+  char const* _data {nullptr};
+  Size _size {0};
+};
+} // namespace gabe::utils::file
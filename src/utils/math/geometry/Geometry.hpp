@@ -145,12 +145,14 @@ struct Volume {
             (firstCorner.z + secondCorner.z) / 2};
   }
 
-  [[nodiscard]] auto distance(Position const& position) const -> float {
+  [[nodiscard]] auto squaredDistance(Position const& position) const -> float {
     Position closest = closestPoint(position);
     auto distance = Position {closest.x - position.x, closest.y - position.y, closest.z - position.z};
-    return std::sqrt(distance.x * distance.x + distance.y * distance.y + distance.z * distance.z);
+    return distance.x * distance.x + distance.y * distance.y + distance.z * distance.z;
   }
 
+  [[nodiscard]] auto distance(Position const& position) const -> float { return std::sqrt(squaredDistance(position)); }
+
   [[nodiscard]] auto distance(Volume const& other) const -> float { return distance(other.closestPoint(firstCorner)); }
 
   [[nodiscard]] auto closestPoint(Position const& position) const -> Position {
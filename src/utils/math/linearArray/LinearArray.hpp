@@ -11,7 +11,9 @@
 #include <cassert>
 #include <cstring>
 #include <numeric>
+#include <span>
 #include <thread>
+#include <type_traits>
 
 namespace gabe::utils::math {
 
@@ -629,6 +631,16 @@ public:
 };
 
 namespace linearArray {
+//views the nested std::array storage of a linear array as one contiguous run of scalars
+template <typename T> auto flatView(T& array) {
+  using Array = std::remove_const_t<T>;
+  using Scalar = std::conditional_t<std::is_const_v<T>, typename Array::UnderlyingType const,
+                                    typename Array::UnderlyingType>;
+  static_assert(sizeof(Array) == Array::total_size() * sizeof(typename Array::UnderlyingType),
+                "Linear array storage is not contiguous");
+  return std::span<Scalar, Array::total_size()> {reinterpret_cast<Scalar*>(&array), Array::total_size()};
+}
+
 template <
     typename... Types,
     typename R = typename impl::TransformMLAtoLA<LinearArray<std::common_type_t<Types...>, sizeof...(Types)>>::type>
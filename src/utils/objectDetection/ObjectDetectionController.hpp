@@ -6,6 +6,7 @@
 
 #include "Exceptions.hpp"
 #include "types.hpp"
+#include "utils/trace/Trace.hpp"
 #include <array>
 #include <iostream>
 #include <regex>
@@ -84,7 +85,8 @@ public:
     close(_channel[1]);
   }
 
-  auto analyzeImage(unsigned char* data) -> std::vector<BoundingBox> {
+  auto analyzeImage(unsigned char const* data) -> std::vector<BoundingBox> {
+    trace::Span span {"analyzeImage", trace::Stage::DETECTION};
     static constexpr auto imageSize = expectedScreenWidth * (expectedScreenHeight - screenHeightOffset) * 3;
 
     auto* response = new char[256];
@@ -0,0 +1,89 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Random.hpp"
+#include <cassert>
+#include <span>
+#include <types.hpp>
+#include <vector>
+
+namespace gabe::utils::random {
+//constant time sampling of a discrete distribution (Vose's alias method); building is linear in the number of weights,
+//so tables are meant to be rebuilt only when the weights change
+class AliasTable {
+public:
+  AliasTable() = default;
+  AliasTable(AliasTable const&) = default;
+  AliasTable(AliasTable&&) noexcept = default;
+  explicit AliasTable(std::span<float const> weights) { rebuild(weights); }
+
+  auto operator=(AliasTable const&) -> AliasTable& = default;
+  auto operator=(AliasTable&&) noexcept -> AliasTable& = default;
+
+  auto rebuild(std::span<float const> weights) -> void {
+    auto const count = weights.size();
+    _probability.assign(count, 1.0f);
+    _alias.resize(count);
+    for (Size idx = 0; idx < count; ++idx) {
+      _alias[idx] = idx;
+    }
+
+    auto total = 0.0f;
+    for (auto weight : weights) {
+      assert(weight >= 0.0f && "Alias table weights must not be negative");
+      total += weight;
+    }
+    if (count == 0 || total <= 0.0f) {
+      return;
+    }
+
+    std::vector<float> scaled(count);
+    std::vector<Size> small {};
+    std::vector<Size> large {};
+    for (Size idx = 0; idx < count; ++idx) {
+      scaled[idx] = weights[idx] * static_cast<float>(count) / total;
+      (scaled[idx] < 1.0f ? small : large).push_back(idx);
+    }
+
+    while (!small.empty() && !large.empty()) {
+      auto const lessIdx = small.back();
+      auto const moreIdx = large.back();
+      small.pop_back();
+      _probability[lessIdx] = scaled[lessIdx];
+      _alias[lessIdx] = moreIdx;
+      scaled[moreIdx] -= 1.0f - scaled[lessIdx];
+      if (scaled[moreIdx] < 1.0f) {
+        large.pop_back();
+        small.push_back(moreIdx);
+      }
+    }
+    //whatever is left is full up to rounding errors
+    for (auto idx : small) {
+      _probability[idx] = 1.0f;
+    }
+    for (auto idx : large) {
+      _probability[idx] = 1.0f;
+    }
+  }
+
+  template <typename Generator> [[nodiscard]] auto sample(Generator& generator) const -> Size {
+    assert(!empty() && "Sampling from an empty alias table");
+    auto const column = static_cast<Size>(generator.bounded(_probability.size()));
+    return generator.template canonical<float>() < _probability[column] ? column : _alias[column];
+  }
+
+  //the chance of keeping column idx once drawn, and where it goes otherwise
+  [[nodiscard]] auto probability(Size idx) const -> float { return _probability[idx]; }
+  [[nodiscard]] auto alias(Size idx) const -> Size { return _alias[idx]; }
+
+  [[nodiscard]] auto size() const -> Size { return _probability.size(); }
+  [[nodiscard]] auto empty() const -> bool { return _probability.empty(); }
+
+private:
+  std::vector<float> _probability {};
+  std::vector<Size> _alias {};
+};
+} // namespace gabe::utils::random
@@ -0,0 +1,185 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <types.hpp>
+#include <utility>
+
+namespace gabe::utils::random {
+static constexpr uint64 defaultSeed = 0x9E3779B97F4A7C15ull;
+
+namespace impl {
+constexpr auto rotl(uint64 value, int shift) -> uint64 { return (value << shift) | (value >> (64 - shift)); }
+} // namespace impl
+
+class SplitMix64 {
+public:
+  using result_type = uint64;
+
+  constexpr explicit SplitMix64(uint64 seed = defaultSeed) : _state {seed} {}
+
+  static constexpr auto min() -> result_type { return std::numeric_limits<result_type>::min(); }
+  static constexpr auto max() -> result_type { return std::numeric_limits<result_type>::max(); }
+
+  constexpr auto operator()() -> result_type {
+    auto z = (_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+private:
+  uint64 _state;
+};
+
+class Xoshiro256 {
+public:
+  using result_type = uint64;
+
+  constexpr explicit Xoshiro256(uint64 seed = defaultSeed) {
+    SplitMix64 seeder {seed};
+    for (auto& word : _state) {
+      word = seeder();
+    }
+  }
+
+  static constexpr auto min() -> result_type { return std::numeric_limits<result_type>::min(); }
+  static constexpr auto max() -> result_type { return std::numeric_limits<result_type>::max(); }
+
+  constexpr auto operator()() -> result_type {
+    auto const result = impl::rotl(_state[1] * 5, 7) * 9;
+    auto const t = _state[1] << 17;
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = impl::rotl(_state[3], 45);
+    return result;
+  }
+
+  //uniform integer in [0, bound) without modulo bias (Lemire's multiply-shift rejection)
+  constexpr auto bounded(uint64 bound) -> uint64 {
+    auto product = static_cast<unsigned __int128>(operator()()) * bound;
+    auto low = static_cast<uint64>(product);
+    if (low < bound) {
+      auto const threshold = -bound % bound;
+      while (low < threshold) {
+        product = static_cast<unsigned __int128>(operator()()) * bound;
+        low = static_cast<uint64>(product);
+      }
+    }
+    return static_cast<uint64>(product >> 64);
+  }
+
+  //uniform floating point value in [0, 1)
+  template <typename T = double> constexpr auto canonical() -> T {
+    return static_cast<T>(operator()() >> 11) * static_cast<T>(0x1.0p-53);
+  }
+
+  //advances the generator by 2^128 steps; used to hand out non-overlapping streams
+  constexpr auto jump() -> void {
+    constexpr uint64 jumpTable[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull,
+                                    0x39ABDC4529B1661Cull};
+    uint64 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (auto word : jumpTable) {
+      for (auto bit = 0; bit < 64; ++bit) {
+        if (word & (1ull << bit)) {
+          s0 ^= _state[0];
+          s1 ^= _state[1];
+          s2 ^= _state[2];
+          s3 ^= _state[3];
+        }
+        operator()();
+      }
+    }
+    _state[0] = s0;
+    _state[1] = s1;
+    _state[2] = s2;
+    _state[3] = s3;
+  }
+
+  constexpr auto split() -> Xoshiro256 {
+    auto stream = *this;
+    jump();
+    return stream;
+  }
+
+private:
+  uint64 _state[4] {};
+};
+
+//counter-based generator: every (counter, stream) pair maps to its own block of four words, so any block can be
+//produced independently of the others (Philox4x32-10, Salmon et al.)
+class Philox4x32 {
+public:
+  using Block = std::array<uint32, 4>;
+
+  constexpr explicit Philox4x32(uint64 key = defaultSeed) :
+      _key {static_cast<uint32>(key), static_cast<uint32>(key >> 32)} {}
+
+  constexpr auto operator()(uint64 counter, uint64 stream = 0) const -> Block {
+    Block block {static_cast<uint32>(counter), static_cast<uint32>(counter >> 32), static_cast<uint32>(stream),
+                 static_cast<uint32>(stream >> 32)};
+    auto key = _key;
+    for (auto round = 0; round < 10; ++round) {
+      auto const first = static_cast<uint64>(0xD2511F53u) * block[0];
+      auto const second = static_cast<uint64>(0xCD9E8D57u) * block[2];
+      block = {static_cast<uint32>(second >> 32) ^ block[1] ^ key[0], static_cast<uint32>(second),
+               static_cast<uint32>(first >> 32) ^ block[3] ^ key[1], static_cast<uint32>(first)};
+      key[0] += 0x9E3779B9u;
+      key[1] += 0xBB67AE85u;
+    }
+    return block;
+  }
+
+private:
+  std::array<uint32, 2> _key;
+};
+
+//maps 32 random bits to the open interval (0, 1)
+template <typename T> constexpr auto openUnit(uint32 bits) -> T {
+  if constexpr (sizeof(T) <= sizeof(float)) {
+    return (static_cast<T>(bits >> 8) + static_cast<T>(0.5)) * static_cast<T>(0x1.0p-24);
+  } else {
+    return (static_cast<T>(bits) + static_cast<T>(0.5)) * static_cast<T>(0x1.0p-32);
+  }
+}
+
+//Box-Muller transform of one block into four standard normal values
+template <typename T> auto standardNormal(Philox4x32::Block const& block) -> std::array<T, 4> {
+  constexpr auto twoPi = static_cast<T>(6.283185307179586);
+  auto const firstRadius = std::sqrt(static_cast<T>(-2) * std::log(openUnit<T>(block[0])));
+  auto const secondRadius = std::sqrt(static_cast<T>(-2) * std::log(openUnit<T>(block[2])));
+  auto const firstAngle = twoPi * openUnit<T>(block[1]);
+  auto const secondAngle = twoPi * openUnit<T>(block[3]);
+  return {firstRadius * std::cos(firstAngle), firstRadius * std::sin(firstAngle), secondRadius * std::cos(secondAngle),
+          secondRadius * std::sin(secondAngle)};
+}
+
+namespace impl {
+inline auto streamSeeds() -> std::atomic<uint64>& {
+  static std::atomic<uint64> seeds {static_cast<uint64>(std::random_device {}()) << 32 | std::random_device {}()};
+  return seeds;
+}
+} // namespace impl
+
+//generators handed out by nextStream are derived from this sequence in the order they are requested; seeding it before
+//they are created makes every consumer reproducible
+inline auto seedStreams(uint64 seed) -> void { impl::streamSeeds() = seed; }
+inline auto nextStream() -> Xoshiro256 { return Xoshiro256 {SplitMix64 {impl::streamSeeds().fetch_add(1)}()}; }
+
+template <typename It, typename Generator> constexpr auto shuffle(It first, It last, Generator& generator) -> void {
+  for (auto count = static_cast<uint64>(last - first); count > 1; --count) {
+    auto target = generator.bounded(count);
+    std::swap(first[count - 1], first[target]);
+  }
+}
+} // namespace gabe::utils::random
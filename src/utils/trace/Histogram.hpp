@@ -0,0 +1,79 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "types.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+namespace gabe::utils::trace {
+//log-linear histogram in the style of HdrHistogram: values below 2^precisionBits are exact and every power of two above
+//is split into 2^(precisionBits - 1) buckets, keeping the relative error of any percentile under 2^(1 - precisionBits)
+template <Size precisionBits = 7> class Histogram {
+public:
+  static_assert(precisionBits >= 2 && precisionBits < 32, "Unsupported histogram precision");
+
+  Histogram() = default;
+  Histogram(Histogram const&) = default;
+  Histogram(Histogram&&) noexcept = default;
+
+  auto operator=(Histogram const&) -> Histogram& = default;
+  auto operator=(Histogram&&) noexcept -> Histogram& = default;
+
+  auto record(uint64 value) -> void {
+    ++_counts[bucket(value)];
+    ++_count;
+    _max = std::max(_max, value);
+  }
+
+  [[nodiscard]] auto count() const -> uint64 { return _count; }
+  [[nodiscard]] auto max() const -> uint64 { return _max; }
+
+  //highest value equivalent to the one at the given percentile, in [0, 100]
+  [[nodiscard]] auto percentile(double percent) const -> uint64 {
+    if (_count == 0) {
+      return 0;
+    }
+    auto const rank =
+        std::max<uint64>(1, static_cast<uint64>(std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * _count)));
+    uint64 seen {};
+    for (Size idx = 0; idx < _counts.size(); ++idx) {
+      seen += _counts[idx];
+      if (seen >= rank) {
+        return std::min(upperBound(idx), _max);
+      }
+    }
+    return _max;
+  }
+
+private:
+  static constexpr uint64 exactCount = 1ull << precisionBits;
+  static constexpr uint64 halfCount = exactCount / 2;
+  static constexpr Size bucketCount = exactCount + (64 - precisionBits) * halfCount;
+
+  static constexpr auto bucket(uint64 value) -> Size {
+    if (value < exactCount) {
+      return value;
+    }
+    auto const shift = static_cast<Size>(std::bit_width(value)) - precisionBits;
+    return exactCount + (shift - 1) * halfCount + ((value >> shift) - halfCount);
+  }
+
+  static constexpr auto upperBound(Size idx) -> uint64 {
+    if (idx < exactCount) {
+      return idx;
+    }
+    auto const shift = (idx - exactCount) / halfCount + 1;
+    auto const top = (idx - exactCount) % halfCount + halfCount;
+    return ((top + 1) << shift) - 1;
+  }
+
+  std::vector<uint64> _counts = std::vector<uint64>(bucketCount);
+  uint64 _count {};
+  uint64 _max {};
+};
+} // namespace gabe::utils::trace
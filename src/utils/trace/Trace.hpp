@@ -0,0 +1,311 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#pragma once
+
+#include "Histogram.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//span tracing for the capture to input pipeline. Spans go to per thread ring buffers that only their thread writes, so
+//recording is two timestamp reads and a handful of relaxed stores; everything else happens when a report is exported.
+//A flow id (the frame sequence number) is carried through thread local state so that spans belonging to the same
+//captured frame can be joined into end to end latencies
+namespace gabe::utils::trace {
+enum class Stage : uint8 { CAPTURE, DETECTION, EVALUATION, QUEUEING, SOLVE };
+
+constexpr auto toString(Stage stage) -> char const* {
+  switch (stage) {
+    using enum Stage;
+    case CAPTURE: return "capture";
+    case DETECTION: return "detection";
+    case EVALUATION: return "evaluation";
+    case QUEUEING: return "queueing";
+    case SOLVE: return "solve";
+  }
+  return "<unknown stage>";
+}
+
+//raw timestamp; the time stamp counter where there is one, nanoseconds of the steady clock otherwise
+inline auto ticks() -> uint64 {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+namespace impl {
+struct Anchor {
+  uint64 ticks;
+  std::chrono::steady_clock::time_point time;
+};
+
+inline auto startAnchor() -> Anchor const& {
+  static Anchor const anchor {ticks(), std::chrono::steady_clock::now()};
+  return anchor;
+}
+
+inline auto enabledFlag() -> std::atomic<bool>& {
+  static std::atomic<bool> enabled {false};
+  return enabled;
+}
+
+inline auto dumpFlag() -> std::atomic<bool>& {
+  static std::atomic<bool> dump {false};
+  return dump;
+}
+
+inline auto publishedFlow() -> std::atomic<uint64>& {
+  static std::atomic<uint64> flow {};
+  return flow;
+}
+
+inline thread_local uint64 currentFlow {};
+
+struct RecordData {
+  char const* name;
+  Stage stage;
+  uint64 begin;
+  uint64 end;
+  uint64 flow;
+  uint32 thread;
+};
+
+class Buffer {
+public:
+  static constexpr Size capacity = 1u << 14u;
+
+  explicit Buffer(uint32 thread) : _thread {thread} {}
+
+  auto push(char const* name, Stage stage, uint64 begin, uint64 end, uint64 flow) -> void {
+    auto const head = _head.load(std::memory_order_relaxed);
+    auto& record = _records[head % capacity];
+    record.name.store(name, std::memory_order_relaxed);
+    record.stage.store(stage, std::memory_order_relaxed);
+    record.begin.store(begin, std::memory_order_relaxed);
+    record.end.store(end, std::memory_order_relaxed);
+    record.flow.store(flow, std::memory_order_relaxed);
+    _head.store(head + 1, std::memory_order_release);
+  }
+
+  //records the owner overwrote while they were being copied are dropped
+  auto collect(std::vector<RecordData>& into) const -> void {
+    auto const head = _head.load(std::memory_order_acquire);
+    auto const first = head > capacity ? head - capacity : 0;
+    auto const start = into.size();
+    for (auto idx = first; idx < head; ++idx) {
+      auto const& record = _records[idx % capacity];
+      into.push_back({record.name.load(std::memory_order_relaxed), record.stage.load(std::memory_order_relaxed),
+                      record.begin.load(std::memory_order_relaxed), record.end.load(std::memory_order_relaxed),
+                      record.flow.load(std::memory_order_relaxed), _thread});
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto const overwritten = _head.load(std::memory_order_relaxed);
+    if (overwritten > capacity && overwritten - capacity > first) {
+      auto const lost = std::min(overwritten - capacity - first, head - first);
+      into.erase(into.begin() + static_cast<std::ptrdiff_t>(start),
+                 into.begin() + static_cast<std::ptrdiff_t>(start + lost));
+    }
+  }
+
+private:
+  struct Record {
+    std::atomic<char const*> name {};
+    std::atomic<Stage> stage {};
+    std::atomic<uint64> begin {};
+    std::atomic<uint64> end {};
+    std::atomic<uint64> flow {};
+  };
+
+  std::array<Record, capacity> _records {};
+  std::atomic<uint64> _head {};
+  uint32 _thread;
+};
+
+struct Registry {
+  std::mutex lock {};
+  std::vector<std::unique_ptr<Buffer>> buffers {};
+  std::deque<std::string> names {};
+};
+
+inline auto registry() -> Registry& {
+  static Registry registry {};
+  return registry;
+}
+
+inline auto threadBuffer() -> Buffer& {
+  thread_local Buffer* buffer = [] {
+    auto& reg = registry();
+    std::lock_guard lockGuard {reg.lock};
+    return reg.buffers.emplace_back(std::make_unique<Buffer>(static_cast<uint32>(reg.buffers.size()))).get();
+  }();
+  return *buffer;
+}
+} // namespace impl
+
+inline auto enable(bool enabled = true) -> void {
+  impl::startAnchor();
+  impl::enabledFlag().store(enabled, std::memory_order_relaxed);
+}
+[[nodiscard]] inline auto enabled() -> bool { return impl::enabledFlag().load(std::memory_order_relaxed); }
+
+//async signal safe; the owner of the trace polls dumpRequested and exports from a regular thread
+inline auto requestDump() -> void { impl::dumpFlag().store(true, std::memory_order_relaxed); }
+[[nodiscard]] inline auto dumpRequested() -> bool {
+  return impl::dumpFlag().exchange(false, std::memory_order_relaxed);
+}
+
+//names handed to spans must outlive the trace; dynamic names are interned once, up front
+inline auto intern(std::string_view name) -> char const* {
+  auto& reg = impl::registry();
+  std::lock_guard lockGuard {reg.lock};
+  return reg.names.emplace_back(name).c_str();
+}
+
+inline auto setFlow(uint64 flow) -> void { impl::currentFlow = flow; }
+[[nodiscard]] inline auto currentFlow() -> uint64 { return impl::currentFlow; }
+inline auto takeFlow() -> uint64 { return std::exchange(impl::currentFlow, 0); }
+
+//the flow whose results the game state currently holds; decisions taken on other threads inherit it
+inline auto publishFlow(uint64 flow) -> void { impl::publishedFlow().store(flow, std::memory_order_relaxed); }
+[[nodiscard]] inline auto latestFlow() -> uint64 { return impl::publishedFlow().load(std::memory_order_relaxed); }
+
+inline auto record(char const* name, Stage stage, uint64 begin, uint64 end, uint64 flow = currentFlow()) -> void {
+  if (enabled()) {
+    impl::threadBuffer().push(name, stage, begin, end, flow);
+  }
+}
+
+//records the time between its construction and destruction; the flow defaults to the thread's at destruction
+class Span {
+public:
+  Span() = delete;
+  Span(Span const&) = delete;
+  Span(Span&&) noexcept = delete;
+
+  Span(char const* name, Stage stage) : _name {name}, _stage {stage}, _begin {enabled() ? ticks() : 0} {}
+
+  ~Span() {
+    if (_begin != 0) {
+      record(_name, _stage, _begin, ticks(), _flow != 0 ? _flow : currentFlow());
+    }
+  }
+
+  auto setFlow(uint64 flow) -> void { _flow = flow; }
+
+private:
+  char const* _name;
+  Stage _stage;
+  uint64 _begin;
+  uint64 _flow {};
+};
+
+class Report {
+public:
+  Report() {
+    auto& reg = impl::registry();
+    {
+      std::lock_guard lockGuard {reg.lock};
+      for (auto const& buffer : reg.buffers) {
+        buffer->collect(_records);
+      }
+    }
+    auto const& anchor = impl::startAnchor();
+    auto const elapsedTicks = ticks() - anchor.ticks;
+    auto const elapsedTime = std::chrono::duration<double, std::nano> {std::chrono::steady_clock::now() - anchor.time};
+    _nanosecondsPerTick = elapsedTicks == 0 ? 1.0 : elapsedTime.count() / static_cast<double>(elapsedTicks);
+  }
+
+  //latency percentiles per stage and span name, plus the latency from a frame's capture to the first input based on it
+  [[nodiscard]] auto summary() const -> std::string {
+    std::map<std::pair<Stage, std::string_view>, Histogram<>> histograms {};
+    std::map<uint64, uint64> captureBegin {};
+    std::map<uint64, uint64> firstInput {};
+    for (auto const& record : _records) {
+      histograms[{record.stage, record.name}].record(nanoseconds(record.end - record.begin));
+      if (record.flow == 0) {
+        continue;
+      }
+      if (record.stage == Stage::CAPTURE) {
+        captureBegin[record.flow] = record.begin;
+      } else if (record.stage == Stage::SOLVE) {
+        auto [input, inserted] = firstInput.try_emplace(record.flow, record.end);
+        input->second = inserted ? record.end : std::min(input->second, record.end);
+      }
+    }
+    Histogram<> endToEnd {};
+    for (auto const& [flow, inputEnd] : firstInput) {
+      if (auto capture = captureBegin.find(flow); capture != captureBegin.end() && inputEnd > capture->second) {
+        endToEnd.record(nanoseconds(inputEnd - capture->second));
+      }
+    }
+
+    std::string rez {};
+    auto describe = [&rez](std::string const& label, Histogram<> const& histogram) {
+      auto micros = [](uint64 nanos) {
+        std::array<char, 32> buffer {};
+        snprintf(buffer.data(), buffer.size(), "%.1fus", static_cast<double>(nanos) / 1000.0);
+        return std::string {buffer.data()};
+      };
+      rez += label + ": " + std::to_string(histogram.count()) + " spans, p50 " + micros(histogram.percentile(50))
+          + ", p99 " + micros(histogram.percentile(99)) + ", p999 " + micros(histogram.percentile(99.9)) + ", max "
+          + micros(histogram.max()) + "\n";
+    };
+    for (auto const& [key, histogram] : histograms) {
+      describe(std::string {toString(key.first)} + " " + std::string {key.second}, histogram);
+    }
+    if (endToEnd.count() != 0) {
+      describe("capture to input", endToEnd);
+    }
+    return rez;
+  }
+
+  //complete events in the Chrome trace event format, loadable in chrome://tracing or Perfetto
+  auto writeChromeTrace(std::string const& path) const -> bool {
+    std::unique_ptr<FILE, decltype(&fclose)> file {fopen(path.c_str(), "w"), &fclose};
+    if (!file) {
+      return false;
+    }
+    auto const origin = impl::startAnchor().ticks;
+    fprintf(file.get(), "{\"traceEvents\":[");
+    for (Size idx = 0; idx < _records.size(); ++idx) {
+      auto const& record = _records[idx];
+      fprintf(file.get(),
+              "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+              "\"args\":{\"frame\":%lu}}",
+              idx == 0 ? "" : ",", record.name, toString(record.stage),
+              static_cast<double>(nanoseconds(record.begin - origin)) / 1000.0,
+              static_cast<double>(nanoseconds(record.end - record.begin)) / 1000.0, record.thread, record.flow);
+    }
+    fprintf(file.get(), "\n]}\n");
+    return true;
+  }
+
+  [[nodiscard]] auto size() const -> Size { return _records.size(); }
+
+private:
+  [[nodiscard]] auto nanoseconds(uint64 tickCount) const -> uint64 {
+    return static_cast<uint64>(static_cast<double>(tickCount) * _nanosecondsPerTick);
+  }
+
+  std::vector<impl::RecordData> _records {};
+  double _nanosecondsPerTick {1.0};
+};
+} // namespace gabe::utils::trace
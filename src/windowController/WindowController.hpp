@@ -8,20 +8,27 @@
 #include "multithreaded/runnable/Runnable.hpp"
 #include "multithreaded/synchronizer/Synchronizer.hpp"
 #include <X11/Xlib.h>
-#include <X11/extensions/XTest.h>
 #include <cstdio>
-#include <event/Event.hpp>
-#include <queue>
+#include <event/EventQueue.hpp>
+#include <event/EventSink.hpp>
+#include <event/backend/UInputBackend.hpp>
+#include <event/backend/XTestBackend.hpp>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 namespace gabe {
-class WindowController : public Runnable<WindowController> {
+class WindowController : public Runnable<WindowController>, public EventSink {
 public:
   WindowController() = delete;
   WindowController(WindowController const&) = delete;
   WindowController(WindowController&&) noexcept = delete;
 
-  explicit WindowController(std::string const& pathToWindowFinder, Synchronizer& synchronizer) noexcept(false) :
+  //how input reaches the game; screen captures always go through Xlib
+  enum class Input { XTEST, UINPUT };
+
+  explicit WindowController(std::string const& pathToWindowFinder, Synchronizer& synchronizer,
+                            Input input = Input::XTEST) noexcept(false) :
       _synchronizer {synchronizer} {
     _display = XOpenDisplay(nullptr);
     if (_display == nullptr) {
@@ -32,6 +39,13 @@ public:
     if (!findWindow(pathToWindowFinder)) {
       log("Terminating program", OpState::FAILURE);
     }
+
+    _xTestBackend = std::make_unique<XTestBackend>(_display, _window);
+    _pBackend = _xTestBackend.get();
+    if (input == Input::UINPUT) {
+      _uInputBackend = std::make_unique<UInputBackend>(_xTestBackend.get());
+      _pBackend = _uInputBackend.get();
+    }
   }
 
   auto mainLoop() -> void {
@@ -40,17 +54,30 @@ public:
     } catch (window::DisplayOpeningException const& e) {
       log("Error: " + std::string(e.what()), OpState::FAILURE);
     }
+    std::unique_lock lockGuard {_queueLock};
     if (_eventQueue.empty() && _synchronizer.synchronizationRequired()) {
       _synchronizer.handleSynchronization();
     }
     if (_windowState.focused && !_eventQueue.empty()) {
-      auto event = std::move(_eventQueue.front());
-      _eventQueue.pop();
-      event.get()->solve(_display, _window);
+      auto entry = _eventQueue.pop();
+      lockGuard.unlock();
+      auto const* name = eventName(entry.event);
+      if (entry.enqueuedAt != 0) {
+        utils::trace::record(name, utils::trace::Stage::QUEUEING, entry.enqueuedAt, utils::trace::ticks(), entry.flow);
+      }
+      utils::trace::Span span {name, utils::trace::Stage::SOLVE};
+      span.setFlow(entry.flow);
+      solve(entry.event, *_pBackend);
     }
   }
 
-  auto addEvent(std::unique_ptr<Event>&& ev) { _eventQueue.push(std::move(ev)); }
+  auto addEvent(AnyEvent&& ev, uint64 flow = 0) -> void override {
+    if (isEmpty(ev)) {
+      return;
+    }
+    std::lock_guard lockGuard {_queueLock};
+    _eventQueue.push(std::move(ev), flow);
+  }
 
 private:
   struct WindowState {
@@ -59,7 +86,11 @@ private:
   WindowState _windowState {};
   Window _window {};
   Display* _display;
-  std::queue<std::unique_ptr<Event>> _eventQueue {};
+  std::unique_ptr<XTestBackend> _xTestBackend {};
+  std::unique_ptr<UInputBackend> _uInputBackend {};
+  InputBackend* _pBackend {};
+  EventQueue _eventQueue {};
+  std::mutex _queueLock {};
   Synchronizer& _synchronizer;
 
   auto checkWindowState() noexcept(false) -> void {
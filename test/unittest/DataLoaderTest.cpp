@@ -43,3 +43,33 @@ TEST(DataLoader, LoadDelimSeparatedFile) {
   static_assert(std::is_same_v<decltype(dataset.data()[0].data), LinearArray<float, 7>>);
   static_assert(std::is_same_v<decltype(dataset.data()[0].label), float>);
 }
+
+TEST(DataLoader, LoadDelimSeparatedFileMultithreaded) {
+  auto sequential =
+      loadDelimSeparatedFile<LinearArray<float, 7>>("../../../test/featuretest/datasets/seeds/seeds_dataset.txt", '\t');
+  auto parallel = loadDelimSeparatedFile<LinearArray<float, 7>>(
+      "../../../test/featuretest/datasets/seeds/seeds_dataset.txt", '\t', 4);
+  ASSERT_EQ(parallel.data().size(), sequential.data().size());
+  for (gabe::Size idx = 0; idx < sequential.data().size(); ++idx) {
+    ASSERT_EQ(parallel.data()[idx].data, sequential.data()[idx].data);
+    ASSERT_EQ(parallel.data()[idx].label, sequential.data()[idx].label);
+  }
+  ASSERT_FLOAT_EQ(sequential.data()[0].data[6], 5.22f);
+  ASSERT_EQ(sequential.data().back().label, 3.0f);
+}
+
+TEST(DataLoader, RejectsMalformedFields) {
+  auto const filePath = (std::filesystem::temp_directory_path() / "DataLoaderMalformed.csv").string();
+  for (auto const* line : {"1.5,2x,1\n", "1.5,,abc\n", "1.5,1e99999,1\n"}) {
+    std::ofstream {filePath} << "0.5, +2.5 ,0\n" << line << "3,4,1\n";
+    for (gabe::Size threadCount : {1, 3}) {
+      ASSERT_THROW((loadDelimSeparatedFile<LinearArray<float, 2>>(filePath, ',', threadCount)),
+                   gabe::utils::exceptions::MalformedFieldException);
+    }
+  }
+  std::ofstream {filePath} << "0.5, +2.5 ,0\n3,4,1\n";
+  auto const dataSet = loadDelimSeparatedFile<LinearArray<float, 2>>(filePath);
+  ASSERT_EQ(dataSet.data()[0].data[1], 2.5f);
+  ASSERT_EQ(dataSet.data()[1].label, 1.0f);
+  std::filesystem::remove(filePath);
+}
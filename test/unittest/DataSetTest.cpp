@@ -0,0 +1,141 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "utils/concepts/Concepts.hpp"
+#include "utils/math/linearArray/LinearArray.hpp"
+#include "utils/data/Data.hpp"
+#include "utils/data/sampler/Sampler.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+using gabe::Size;
+using gabe::uint32;
+using gabe::utils::data::BatchSampler;
+using gabe::utils::data::ImageDataPoint;
+using gabe::utils::data::ImageDataSet;
+using gabe::utils::data::NormalizationStatistics;
+using gabe::utils::data::SamplingOrder;
+using gabe::utils::math::LinearArray;
+
+using Sample = LinearArray<float, 2>;
+
+auto makeDataSet(Size size, Size classCount) {
+  std::vector<ImageDataPoint<Sample>> data {};
+  for (Size idx = 0; idx < size; ++idx) {
+    data.push_back({Sample {{static_cast<float>(idx), 0.0f}}, static_cast<float>(idx % classCount)});
+  }
+  return ImageDataSet<Sample> {data};
+}
+
+auto isPermutation(std::span<uint32 const> indices) {
+  std::vector<uint32> sorted {indices.begin(), indices.end()};
+  std::ranges::sort(sorted);
+  for (uint32 idx = 0; idx < sorted.size(); ++idx) {
+    if (sorted[idx] != idx) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST(DataSetTest, SequentialSampler) {
+  auto dataSet = makeDataSet(10, 2);
+  BatchSampler sampler {dataSet, 4, SamplingOrder::SEQUENTIAL};
+  ASSERT_EQ(sampler.batchCount(), 3);
+  ASSERT_EQ(sampler.batch(0).size(), 4);
+  ASSERT_EQ(sampler.batch(2).size(), 2);
+  for (uint32 idx = 0; idx < sampler.size(); ++idx) {
+    ASSERT_EQ(sampler.indices()[idx], idx);
+  }
+}
+
+TEST(DataSetTest, ShuffledSampler) {
+  auto dataSet = makeDataSet(1000, 10);
+  BatchSampler first {dataSet, 32, SamplingOrder::SHUFFLED, 42};
+  BatchSampler second {dataSet, 32, SamplingOrder::SHUFFLED, 42};
+  ASSERT_TRUE(isPermutation(first.indices()));
+  ASSERT_TRUE(std::ranges::equal(first.indices(), second.indices()));
+
+  std::vector<uint32> epochZero {first.indices().begin(), first.indices().end()};
+  first.reshuffle(1);
+  ASSERT_TRUE(isPermutation(first.indices()));
+  ASSERT_FALSE(std::ranges::equal(first.indices(), epochZero));
+
+  first.reshuffle(0);
+  ASSERT_TRUE(std::ranges::equal(first.indices(), epochZero));
+  ASSERT_EQ(dataSet.data()[5].data[0], 5.0f);
+}
+
+TEST(DataSetTest, StratifiedSampler) {
+  auto dataSet = makeDataSet(400, 4);
+  BatchSampler sampler {dataSet, 8, SamplingOrder::STRATIFIED, 7};
+  for (Size epoch = 0; epoch < 3; ++epoch) {
+    sampler.reshuffle(epoch);
+    ASSERT_TRUE(isPermutation(sampler.indices()));
+    for (Size batchIdx = 0; batchIdx < sampler.batchCount(); ++batchIdx) {
+      std::array<int, 4> counts {};
+      for (auto sampleIdx : sampler.batch(batchIdx)) {
+        ++counts[static_cast<Size>(dataSet.data()[sampleIdx].label)];
+      }
+      ASSERT_TRUE(std::ranges::all_of(counts, [](int count) { return count == 2; }));
+    }
+  }
+}
+
+TEST(DataSetTest, StratifiedSamplerNeedsKeys) {
+  struct UnlabeledDataSet {
+    [[nodiscard]] auto data() const -> std::vector<Sample> const& { return samples; }
+    std::vector<Sample> samples;
+  };
+  UnlabeledDataSet const dataSet {std::vector<Sample>(10)};
+  ASSERT_THROW((BatchSampler {dataSet, 4, SamplingOrder::STRATIFIED}),
+               gabe::utils::exceptions::StratificationException);
+  ASSERT_EQ((BatchSampler {dataSet, 4, SamplingOrder::SHUFFLED}).size(), 10);
+  auto const byFirstValue = [](Sample const& sample) { return sample[0]; };
+  ASSERT_EQ((BatchSampler {dataSet, 4, SamplingOrder::STRATIFIED, 7, byFirstValue}).size(), 10);
+}
+
+TEST(DataSetTest, Normalization) {
+  using Image = LinearArray<float, 2, 3>;
+  std::vector<ImageDataPoint<Image>> data {};
+  for (int idx = 0; idx < 5; ++idx) {
+    auto value = static_cast<float>(idx);
+    auto first = LinearArray<float, 3> {{value, 2 * value, 7}};
+    auto second = LinearArray<float, 3> {{-value, 1, 4 - value}};
+    data.push_back({Image {{first, second}}, 0.0f});
+  }
+  ImageDataSet<Image> dataSet {data};
+  auto statistics = dataSet.normalize();
+
+  ASSERT_EQ(statistics.scale()[0][2], 0.0f);
+  ASSERT_EQ(dataSet.data()[2].data[0][0], 0.5f);
+  ASSERT_EQ(dataSet.data()[4].data[0][1], 1.0f);
+  ASSERT_EQ(dataSet.data()[3].data[0][2], 0.0f);
+  ASSERT_EQ(dataSet.data()[1].data[1][0], 0.75f);
+  ASSERT_EQ(dataSet.data()[0].data[1][2], 1.0f);
+
+  auto parallel = NormalizationStatistics<Image>::compute(data, 3);
+  auto sequential = NormalizationStatistics<Image>::compute(data, 1);
+  ASSERT_EQ(parallel.min(), sequential.min());
+  ASSERT_EQ(parallel.scale(), sequential.scale());
+}
+
+TEST(DataSetTest, NormalizationSerialization) {
+  using Image = LinearArray<float, 4>;
+  NormalizationStatistics<Image> statistics {Image {{0, 1, 2, 3}}, Image {{4, 1, 4, 7}}};
+
+  FILE* file = tmpfile();
+  statistics.serialize(file);
+  rewind(file);
+  auto restored = NormalizationStatistics<Image>::deserialize(file);
+  fclose(file);
+
+  ASSERT_EQ(restored.min(), statistics.min());
+  ASSERT_EQ(restored.scale(), statistics.scale());
+
+  auto input = Image {{2, 5, 3, 5}};
+  restored.apply(input);
+  ASSERT_EQ(input, (Image {{0.5f, 0, 0.5f, 0.5f}}));
+}
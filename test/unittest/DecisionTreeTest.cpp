@@ -0,0 +1,64 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "engine/DecisionTree.hpp"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+using gabe::AnyEvent;
+using gabe::GameState;
+using gabe::utils::BoundingBox;
+
+//finds the same enemy in every frame and counts the frames it was given
+struct FixedDetector {
+  explicit FixedDetector(std::string const&) {}
+
+  auto analyzeImage(unsigned char const*) -> std::vector<BoundingBox> {
+    ++analyzedFrames;
+    return {{{900, 500}, {1000, 600}}};
+  }
+
+  static inline int analyzedFrames = 0;
+};
+
+auto gameState() -> std::unique_ptr<GameState> {
+  return std::make_unique<GameState>(GABE_MAPS_FOLDER "de_dust2.nav");
+}
+
+auto publishFrame(GameState& state) -> void {
+  ASSERT_TRUE(state.frames.beginCapture());
+  state.frames.publish(gabe::FrameRing::Clock::now());
+}
+
+auto tick(gabe::DecisionTree& tree) -> AnyEvent {
+  auto event = tree.evaluate();
+  tree.postEvaluation();
+  return event;
+}
+} // namespace
+
+TEST(DecisionTreeTest, EnemyDetectionActsOncePerFrame) {
+  auto const state = gameState();
+  gabe::EnemyDetectionTree<FixedDetector> tree {*state, ""};
+  tree.addDecision(1.0f, std::make_unique<gabe::SprayShootingTree>(*state));
+  FixedDetector::analyzedFrames = 0;
+
+  ASSERT_TRUE(gabe::isEmpty(tick(tree)));
+  publishFrame(*state);
+  auto aimEvents = 0;
+  for (auto idx = 0; idx < 2; ++idx) {
+    if (std::holds_alternative<gabe::SprayEvent>(tick(tree))) {
+      ++aimEvents;
+    }
+  }
+  ASSERT_EQ(aimEvents, 1);
+  ASSERT_EQ(FixedDetector::analyzedFrames, 1);
+
+  publishFrame(*state);
+  ASSERT_TRUE(std::holds_alternative<gabe::SprayEvent>(tick(tree)));
+  ASSERT_EQ(FixedDetector::analyzedFrames, 2);
+}
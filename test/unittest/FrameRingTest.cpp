@@ -0,0 +1,65 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "multithreaded/frameRing/FrameRing.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <thread>
+
+namespace {
+using gabe::FrameRing;
+using gabe::uint64;
+} // namespace
+
+TEST(FrameRingTest, LatestFrame) {
+  FrameRing frames {4};
+  ASSERT_EQ(frames.latest().sequence, 0);
+
+  ASSERT_TRUE(frames.beginCapture());
+  ASSERT_FALSE(frames.beginCapture());
+  std::fill_n(frames.captureBuffer(), 4, 1);
+  frames.publish(FrameRing::Clock::now());
+
+  auto first = frames.latest();
+  ASSERT_EQ(first.sequence, 1);
+  ASSERT_EQ(first.data[3], 1);
+
+  for (unsigned char value = 2; value < 4; ++value) {
+    ASSERT_TRUE(frames.beginCapture());
+    std::fill_n(frames.captureBuffer(), 4, value);
+    frames.publish(FrameRing::Clock::now());
+    ASSERT_EQ(first.data[0], 1);
+  }
+  auto latest = frames.latest();
+  ASSERT_EQ(latest.sequence, 3);
+  ASSERT_EQ(latest.data[0], 3);
+  ASSERT_EQ(frames.latest().sequence, 3);
+}
+
+TEST(FrameRingTest, ConcurrentCaptureAndConsumption) {
+  constexpr uint64 frameCount = 20000;
+  constexpr gabe::Size frameSize = 256;
+  FrameRing frames {frameSize};
+
+  std::jthread producer {[&frames] {
+    for (uint64 idx = 1; idx <= frameCount; ++idx) {
+      while (!frames.beginCapture()) {
+        std::this_thread::yield();
+      }
+      std::fill_n(frames.captureBuffer(), frameSize, static_cast<unsigned char>(idx));
+      frames.publish(FrameRing::Clock::now());
+    }
+  }};
+
+  uint64 lastSequence {};
+  while (lastSequence < frameCount) {
+    auto frame = frames.latest();
+    ASSERT_GE(frame.sequence, lastSequence);
+    if (frame.sequence != 0) {
+      auto const expected = static_cast<unsigned char>(frame.sequence);
+      ASSERT_TRUE(std::all_of(frame.data, frame.data + frameSize, [expected](auto e) { return e == expected; }));
+    }
+    lastSequence = frame.sequence;
+  }
+}
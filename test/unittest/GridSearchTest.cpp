@@ -0,0 +1,104 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "engine/GridSearch.hpp"
+#include "utils/random/Random.hpp"
+#include "gtest/gtest.h"
+#include <numbers>
+#include <queue>
+
+namespace {
+using gabe::GridSearch;
+using gabe::NavigationGrid;
+using gabe::Position;
+using gabe::Size;
+using gabe::Volume;
+using gabe::utils::random::Xoshiro256;
+using Cell = NavigationGrid::Cell;
+
+//the same moves and costs as GridSearch, searched exhaustively
+auto dijkstraCost(NavigationGrid const& grid, Cell start, std::vector<Volume> const& goals) -> float {
+  std::vector<float> cost(grid.size(), std::numeric_limits<float>::max());
+  std::priority_queue<std::pair<float, Cell>, std::vector<std::pair<float, Cell>>, std::greater<>> queue {};
+  cost[start] = 0.0f;
+  queue.emplace(0.0f, start);
+  auto rez = std::numeric_limits<float>::max();
+  while (!queue.empty()) {
+    auto [current, cell] = queue.top();
+    queue.pop();
+    if (current > cost[cell]) {
+      continue;
+    }
+    auto volume = grid.volume(cell);
+    if (std::ranges::any_of(goals, [&volume](Volume const& goal) { return goal.intersects(volume); })) {
+      rez = std::min(rez, current);
+      continue;
+    }
+    auto line = static_cast<long>(grid.line(cell));
+    auto column = static_cast<long>(grid.column(cell));
+    for (long lineStep = -1; lineStep <= 1; ++lineStep) {
+      for (long columnStep = -1; columnStep <= 1; ++columnStep) {
+        auto nextLine = line + lineStep;
+        auto nextColumn = column + columnStep;
+        if ((lineStep == 0 && columnStep == 0) || nextLine < 0 || nextColumn < 0
+            || nextLine >= static_cast<long>(grid.lines()) || nextColumn >= static_cast<long>(grid.columns())) {
+          continue;
+        }
+        if (lineStep != 0 && columnStep != 0
+            && (!grid.accessible(grid.cell(line, nextColumn)) || !grid.accessible(grid.cell(nextLine, column)))) {
+          continue;
+        }
+        auto next = grid.cell(nextLine, nextColumn);
+        auto step = (lineStep != 0 && columnStep != 0 ? std::numbers::sqrt2_v<float> : 1.0f)
+            + (grid.accessible(next) ? 0.0f : GridSearch::blockedPenalty);
+        if (current + step < cost[next]) {
+          cost[next] = current + step;
+          queue.emplace(cost[next], next);
+        }
+      }
+    }
+  }
+  return rez;
+}
+
+auto randomBox(Xoshiro256& generator, float extent, float size) -> Volume {
+  auto coordinate = [&generator](float bound) { return static_cast<float>(generator.bounded(1000)) / 1000.0f * bound; };
+  auto x = coordinate(extent);
+  auto y = coordinate(extent);
+  return {{x, y, 0.0f}, {x + coordinate(size) + 1.0f, y + coordinate(size) + 1.0f, 100.0f}};
+}
+} // namespace
+
+TEST(GridSearchTest, FindsCheapestPath) {
+  Xoshiro256 generator {3};
+  GridSearch search {};
+  for (Size round = 0; round < 50; ++round) {
+    std::vector<Volume> obstacles {};
+    for (Size idx = 0; idx < 12; ++idx) {
+      obstacles.push_back(randomBox(generator, 400.0f, 80.0f));
+    }
+    NavigationGrid grid {Volume {{0.0f, 0.0f, 0.0f}, {400.0f + static_cast<float>(round), 300.0f, 100.0f}}, obstacles};
+    std::vector<Volume> goals {randomBox(generator, 280.0f, 30.0f)};
+    auto start = static_cast<Cell>(generator.bounded(grid.size()));
+
+    ASSERT_TRUE(search.search(grid, start, goals));
+    ASSERT_NEAR(search.cost(), dijkstraCost(grid, start, goals), 1e-3f);
+
+    auto cellCount = Size {0};
+    for (auto cell = search.goal(); cell != start; cell = search.parent(cell)) {
+      ASSERT_LT(++cellCount, grid.size());
+    }
+    auto goalVolume = grid.volume(search.goal());
+    ASSERT_TRUE(goals.front().intersects(goalVolume));
+  }
+}
+
+TEST(GridSearchTest, UnreachableGoal) {
+  NavigationGrid grid {Volume {{0.0f, 0.0f, 0.0f}, {100.0f, 100.0f, 100.0f}}, {}};
+  GridSearch search {};
+  std::vector<Volume> goals {Volume {{500.0f, 500.0f, 0.0f}, {510.0f, 510.0f, 10.0f}}};
+  ASSERT_FALSE(search.search(grid, 0, goals));
+  ASSERT_EQ(search.goal(), GridSearch::noCell);
+  ASSERT_EQ(search.expanded(), grid.size());
+}
@@ -0,0 +1,82 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "engine/GridSearch.hpp"
+#include "engine/IncrementalSearch.hpp"
+#include "utils/random/Random.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+using gabe::GridSearch;
+using gabe::IncrementalSearch;
+using gabe::NavigationGrid;
+using gabe::Size;
+using gabe::Volume;
+using gabe::utils::random::Xoshiro256;
+using Cell = NavigationGrid::Cell;
+
+auto obstacles(Xoshiro256& generator) -> std::vector<Volume> {
+  std::vector<Volume> rez {};
+  for (Size idx = 0; idx < 10; ++idx) {
+    auto x = static_cast<float>(generator.bounded(300));
+    auto y = static_cast<float>(generator.bounded(200));
+    rez.push_back({{x, y, 0.0f}, {x + static_cast<float>(generator.bounded(60)) + 1.0f,
+                                  y + static_cast<float>(generator.bounded(60)) + 1.0f, 50.0f}});
+  }
+  return rez;
+}
+} // namespace
+
+TEST(IncrementalSearchTest, MatchesFullSearchWhileMoving) {
+  Xoshiro256 generator {5};
+  NavigationGrid grid {Volume {{0.0f, 0.0f, 0.0f}, {300.0f, 200.0f, 50.0f}}, obstacles(generator)};
+  std::vector<Volume> goals {Volume {{280.0f, 90.0f, 0.0f}, {300.0f, 110.0f, 50.0f}}};
+  IncrementalSearch planner {};
+  GridSearch search {};
+  planner.reset(grid, goals);
+
+  Cell start = grid.cell(0, 0);
+  ASSERT_TRUE(planner.plan(start));
+  auto const firstExpansion = planner.expanded();
+  Size steps = 0;
+  Size repairs = 0;
+  while (!planner.goal(start)) {
+    ASSERT_TRUE(planner.plan(start));
+    repairs += planner.expanded();
+    ASSERT_TRUE(search.search(grid, start, goals));
+    ASSERT_NEAR(planner.cost(start), search.cost(), 1e-3f);
+    start = planner.next(start);
+    ASSERT_NE(start, IncrementalSearch::noCell);
+    ASSERT_LT(++steps, grid.size());
+  }
+  //following the route needs no repairs
+  ASSERT_EQ(repairs, 0);
+  ASSERT_GT(firstExpansion, 0);
+}
+
+TEST(IncrementalSearchTest, RepairsAfterAccessibilityChanges) {
+  Xoshiro256 generator {9};
+  NavigationGrid grid {Volume {{0.0f, 0.0f, 0.0f}, {300.0f, 200.0f, 50.0f}}, obstacles(generator)};
+  std::vector<Volume> goals {Volume {{0.0f, 180.0f, 0.0f}, {30.0f, 200.0f, 50.0f}}};
+  IncrementalSearch planner {};
+  GridSearch search {};
+  planner.reset(grid, goals);
+
+  auto start = grid.cell(grid.lines() - 1, 0);
+  ASSERT_TRUE(planner.plan(start));
+  for (Size round = 0; round < 40; ++round) {
+    for (Size idx = 0; idx < 5; ++idx) {
+      auto cell = static_cast<Cell>(generator.bounded(grid.size()));
+      grid.setAccessible(cell, !grid.accessible(cell));
+      planner.setAccessible(cell, grid.accessible(cell));
+    }
+    auto next = planner.next(start);
+    if (next != IncrementalSearch::noCell && !planner.goal(next)) {
+      start = next;
+    }
+    ASSERT_TRUE(planner.plan(start));
+    ASSERT_TRUE(search.search(grid, start, goals));
+    ASSERT_NEAR(planner.cost(start), search.cost(), 1e-3f);
+  }
+}
@@ -0,0 +1,73 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "event/Event.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+using gabe::Action;
+using gabe::RecordingBackend;
+using namespace std::chrono_literals;
+} // namespace
+
+TEST(InputBackendTest, KeyPressTiming) {
+  RecordingBackend backend {};
+  gabe::KeyPressEvent {'a', 100}.solve(backend);
+
+  auto const& performed = backend.performed();
+  ASSERT_EQ(performed.size(), 2);
+  ASSERT_EQ(performed[0].action.type, Action::Type::KEY);
+  ASSERT_EQ(performed[0].action.code, 'a');
+  ASSERT_TRUE(performed[0].action.press);
+  ASSERT_FALSE(performed[1].action.press);
+  ASSERT_EQ(performed[1].time, 50us);
+  ASSERT_EQ(backend.now(), 100us);
+}
+
+TEST(InputBackendTest, DelaysAdvanceVirtualTime) {
+  RecordingBackend backend {};
+  gabe::AnyEvent event {gabe::MovementEvent {gabe::Vector {10.0f, 0.0f}, 180000}};
+  gabe::solve(event, backend);
+
+  auto const& performed = backend.performed();
+  ASSERT_EQ(performed.size(), 3);
+  ASSERT_EQ(performed[0].action.code, 'w');
+  ASSERT_EQ(performed[1].action.type, Action::Type::WAIT);
+  ASSERT_EQ(performed[2].time, 180050us);
+  ASSERT_EQ(backend.now(), 180100us);
+}
+
+TEST(InputBackendTest, CommandTyping) {
+  RecordingBackend backend {};
+  gabe::CommandEvent {"a_b"}.solve(backend);
+
+  std::string typed {};
+  std::string shifted {};
+  auto shiftHeld = false;
+  for (auto const& [action, time] : backend.performed()) {
+    if (action.type != Action::Type::KEY) {
+      continue;
+    }
+    if (action.code == gabe::Keys::SHIFT) {
+      shiftHeld = action.press;
+    } else if (action.press) {
+      typed.push_back(static_cast<char>(action.code));
+      if (shiftHeld) {
+        shifted.push_back(static_cast<char>(action.code));
+      }
+    }
+  }
+  ASSERT_EQ(typed, std::string {"~a_b"} + gabe::Keys::RETURN + gabe::Keys::ESCAPE);
+  ASSERT_EQ(shifted, "_");
+}
+
+TEST(InputBackendTest, CaptureWithoutScreen) {
+  gabe::FrameRing frames {16};
+  ASSERT_TRUE(frames.beginCapture());
+  gabe::NullBackend backend {};
+  gabe::ScreenshotEvent {frames}.solve(backend);
+
+  ASSERT_EQ(frames.latest().sequence, 0);
+  ASSERT_TRUE(frames.beginCapture());
+}
@@ -51,3 +51,46 @@ TEST(InitializationTest, UniformInitialization) {
   ASSERT_TRUE(static_cast<double>(lowerBound) < minVal);
   ASSERT_TRUE(static_cast<double>(upperBound) > maxVal);
 }
+
+TEST(InitializationTest, SeededInitialization) {
+  LinearArray<double, 25, 35> first;
+  LinearArray<double, 25, 35> second;
+  LinearArray<double, 25, 35> third;
+  HeInitialization<> {42}(first);
+  HeInitialization<> {42}(second);
+  HeInitialization<> {43}(third);
+  ASSERT_EQ(first, second);
+  ASSERT_NE(first, third);
+
+  UniformInitialization<-2, 2> ui {7};
+  LinearArray<float, 3, 5> uniformFirst;
+  LinearArray<float, 3, 5> uniformSecond;
+  ui(uniformFirst);
+  ui(uniformSecond);
+  ASSERT_NE(uniformFirst, uniformSecond);
+}
+
+TEST(InitializationTest, ParallelNormalInitialization) {
+  auto weights = std::make_unique<LinearArray<float, 512, 256>>();
+  XavierInitialization<> {3}(*weights);
+  auto copy = std::make_unique<LinearArray<float, 512, 256>>();
+  XavierInitialization<> {3}(*copy);
+  ASSERT_EQ(*weights, *copy);
+
+  auto values = linearArray::flatView(*weights);
+  auto mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+  auto squares = std::accumulate(values.begin(), values.end(), 0.0, [](double acc, float x) { return acc + x * x; });
+  auto deviation = std::sqrt(squares / values.size() - mean * mean);
+  auto expectedDeviation = std::sqrt(6.0 / (256 + 512));
+  ASSERT_NEAR(mean, 0, 0.01 * expectedDeviation);
+  ASSERT_NEAR(deviation, expectedDeviation, 0.01 * expectedDeviation);
+}
+
+//known-answer vectors of the Philox4x32-10 reference implementation (Random123)
+TEST(InitializationTest, PhiloxKnownAnswers) {
+  using gabe::utils::random::Philox4x32;
+  ASSERT_EQ(Philox4x32 {0}(0, 0), (Philox4x32::Block {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+  ASSERT_EQ(Philox4x32 {~0ull}(~0ull, ~0ull), (Philox4x32::Block {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}));
+  ASSERT_EQ(Philox4x32 {0x299f31d0a4093822ull}(0x85a308d3243f6a88ull, 0x0370734413198a2eull),
+            (Philox4x32::Block {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}));
+}
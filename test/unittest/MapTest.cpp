@@ -0,0 +1,434 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "engine/LineOfSight.hpp"
+#include "engine/Map.hpp"
+#include "engine/MapDescription.hpp"
+#include "engine/Movement.hpp"
+#include "engine/Path.hpp"
+#include "utils/random/Random.hpp"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <random>
+#include <ranges>
+
+namespace {
+using gabe::Map;
+using gabe::Position;
+using gabe::Size;
+using gabe::utils::random::Xoshiro256;
+
+auto const descriptionPath = "../../../data/maps/de_dust2.txt";
+
+auto dust2() -> Map const& {
+  static Map const map {gabe::parseMapDescription(gabe::utils::file::MappedFile {descriptionPath}.text())};
+  return map;
+}
+
+auto bruteForceZone(Map const& map, Position const& position) -> Map::ZoneId {
+  Map::ZoneId rez {};
+  for (Map::ZoneId id = 1; id < map.zoneCount(); ++id) {
+    if (map.zone(id).zone.volume.distance(position) < map.zone(rez).zone.volume.distance(position)) {
+      rez = id;
+    }
+  }
+  return rez;
+}
+} // namespace
+
+TEST(MapTest, ZoneCentersFindTheirZone) {
+  auto const& map = dust2();
+  for (auto zoneName : {Map::ZoneName::T_SPAWN, Map::ZoneName::PIT, Map::ZoneName::A_SITE, Map::ZoneName::TOP_MID}) {
+    auto const& zone = map.zone(map.zoneId(zoneName));
+    ASSERT_EQ(map.findZone(zone.zone.volume.center()).name, zoneName);
+  }
+}
+
+TEST(MapTest, IndexMatchesLinearScan) {
+  auto const& map = dust2();
+  Xoshiro256 generator {7};
+  std::uniform_real_distribution<float> xy {-2500.0f, 4500.0f};
+  std::uniform_real_distribution<float> z {-400.0f, 600.0f};
+  for (Size idx = 0; idx < 20000; ++idx) {
+    Position const position {xy(generator), xy(generator), z(generator)};
+    ASSERT_EQ(map.findZoneId(position), bruteForceZone(map, position))
+        << position.x << " " << position.y << " " << position.z;
+  }
+}
+
+TEST(MapTest, NavigationGridMarksObstacles) {
+  auto const& map = dust2();
+  for (Map::ZoneId id = 0; id < map.zoneCount(); ++id) {
+    auto const& zone = map.zone(id).zone;
+    auto const& grid = map.navigationGrid(id);
+    ASSERT_EQ(map.zoneId(map.zone(id).name), id);
+    ASSERT_GT(grid.size(), 0);
+    for (gabe::NavigationGrid::Cell cell = 0; cell < grid.size(); ++cell) {
+      auto const volume = grid.volume(cell);
+      ASSERT_TRUE(zone.volume.containsInXY(volume.center()));
+      auto blocked = std::ranges::any_of(zone.obstacles, [&volume](auto const& ob) { return volume.intersects(ob); });
+      ASSERT_EQ(grid.accessible(cell), !blocked);
+      ASSERT_EQ(grid.closestCell(volume.center()), cell);
+    }
+  }
+}
+
+TEST(MapTest, RoutesAreShortest) {
+  auto const& map = dust2();
+  for (Map::ZoneId start = 0; start < map.zoneCount(); ++start) {
+    std::vector<float> hops(map.zoneCount(), -1.0f);
+    std::queue<Map::ZoneId> queue {};
+    hops[start] = 0.0f;
+    queue.push(start);
+    while (!queue.empty()) {
+      auto zone = queue.front();
+      queue.pop();
+      for (auto const& transition : map.transitions(zone)) {
+        auto next = transition.zone;
+        if (hops[next] < 0.0f) {
+          hops[next] = hops[zone] + 1.0f;
+          queue.push(next);
+        }
+      }
+    }
+
+    for (Map::ZoneId target = 0; target < map.zoneCount(); ++target) {
+      if (hops[target] < 0.0f) {
+        ASSERT_EQ(map.nextHop(start, target), Map::noZone);
+        continue;
+      }
+      ASSERT_EQ(map.routeCost(start, target), hops[target]);
+      gabe::ShortestPathPolicy policy {map};
+      policy.getPath(map.zone(start).name, map.zone(target).name);
+      ASSERT_EQ(policy.path.size(), std::max(1.0f, hops[target]));
+      ASSERT_EQ(policy.path.front(), target);
+      auto previous = start;
+      for (auto zone : policy.path | std::views::reverse | std::views::drop(start == target ? 1 : 0)) {
+        ASSERT_FALSE(map.possibleTransitions(previous, zone).empty());
+        previous = zone;
+      }
+    }
+  }
+}
+
+TEST(MapTest, TransitionsBetweenZones) {
+  auto const& map = dust2();
+  auto const tSpawn = map.zoneId(Map::ZoneName::T_SPAWN);
+  auto const tSpawnExit = map.zoneId(Map::ZoneName::T_SPAWN_EXIT);
+  auto const transitions = map.possibleTransitions(tSpawn, tSpawnExit);
+  ASSERT_EQ(transitions.size(), 2);
+  ASSERT_EQ(transitions[0].movement, Map::RequiredMovement::JUMP);
+  ASSERT_EQ(transitions[1].movement, Map::RequiredMovement::NONE);
+  ASSERT_EQ(map.possibleTransitions(tSpawnExit, tSpawn).size(), 1);
+
+  for (Map::ZoneId start = 0; start < map.zoneCount(); ++start) {
+    for (Map::ZoneId target = 0; target < map.zoneCount(); ++target) {
+      auto expected = std::ranges::count(map.transitions(start), target, &Map::Transition::zone);
+      ASSERT_EQ(map.possibleTransitions(start, target).size(), expected);
+      for (auto const& transition : map.possibleTransitions(start, target)) {
+        ASSERT_EQ(transition.zone, target);
+      }
+    }
+  }
+  ASSERT_EQ(map.watchpoints(map.zoneId(Map::ZoneName::A_SITE)).size(), 4);
+  ASSERT_TRUE(map.watchpoints(tSpawn).empty());
+}
+
+TEST(MapTest, FlowFieldsMatchSearch) {
+  auto const& map = dust2();
+  gabe::GridSearch search {};
+  std::vector<gabe::Volume> goals {};
+  for (Map::ZoneId zone = 0; zone < map.zoneCount(); ++zone) {
+    for (Map::ZoneId target = 0; target < map.zoneCount(); ++target) {
+      auto const& field = map.flowField(target, zone);
+      if (map.possibleTransitions(zone, target).empty()) {
+        ASSERT_TRUE(field.empty());
+        continue;
+      }
+      auto const& grid = map.navigationGrid(zone);
+      map.transitionAreas(zone, target, goals);
+      ASSERT_EQ(field.size(), grid.size());
+      for (gabe::NavigationGrid::Cell cell = 0; cell < grid.size(); cell += 11) {
+        ASSERT_TRUE(search.search(grid, cell, goals));
+        ASSERT_NEAR(field.distance(cell), search.cost(), 1e-2f);
+        if (field.distance(cell) > 0.0f) {
+          auto const following = grid.closestCell(field.waypoint(cell));
+          ASSERT_TRUE(following != cell || std::ranges::any_of(goals, [&](auto const& goal) {
+            return goal.intersects(grid.volume(cell));
+          }));
+        }
+      }
+    }
+  }
+}
+
+TEST(MapTest, IncrementalMovementFollowsFlowFields) {
+  auto const& map = dust2();
+  gabe::IncrementalMovementPolicy policy {map};
+  std::vector<gabe::Volume> areas {};
+  for (Map::ZoneId zone = 0; zone < map.zoneCount(); ++zone) {
+    auto const& grid = map.navigationGrid(zone);
+    for (auto const& transition : map.transitions(zone)) {
+      auto const& field = map.flowField(transition.zone, zone);
+      std::vector const path {transition.zone};
+      map.transitionAreas(zone, transition.zone, areas);
+      auto const crossing = [&areas](Position const& position) {
+        return std::ranges::any_of(areas, [&position](auto const& area) { return area.containsInXY(position); });
+      };
+      for (gabe::NavigationGrid::Cell cell = 0; cell < grid.size(); cell += 13) {
+        if (field.distance(cell) == std::numeric_limits<float>::infinity()) {
+          continue;
+        }
+        //every point handed out is a step down the flow field, until the transitions are reached
+        auto position = grid.center(cell);
+        for (auto current = cell; field.distance(current) > 0.0f && !crossing(position);) {
+          position = policy.getNextPoint(position, zone, path);
+          auto const next = grid.closestCell(position);
+          ASSERT_LT(field.distance(next), field.distance(current));
+          current = next;
+        }
+      }
+    }
+  }
+}
+
+TEST(MapTest, HierarchicalRoutesFollowPortals) {
+  auto const& map = dust2();
+  gabe::HierarchicalPathPolicy policy {map};
+  Xoshiro256 generator {13};
+  for (Size idx = 0; idx < 200; ++idx) {
+    auto const startZone = static_cast<Map::ZoneId>(generator.bounded(map.zoneCount()));
+    auto const target = static_cast<Map::ZoneId>(generator.bounded(map.zoneCount()));
+    auto const& grid = map.navigationGrid(startZone);
+    auto const start = grid.center(static_cast<gabe::NavigationGrid::Cell>(generator.bounded(grid.size())));
+    if (map.findZoneId(start) != startZone) {
+      continue;
+    }
+    policy.getPath(start, map.zone(target).name);
+    if (map.nextHop(startZone, target) == Map::noZone) {
+      ASSERT_TRUE(policy.path.empty());
+      continue;
+    }
+    ASSERT_FALSE(policy.path.empty());
+    ASSERT_EQ(policy.path.front(), target);
+    if (startZone == target) {
+      ASSERT_EQ(policy.cost, 0.0f);
+      continue;
+    }
+
+    //the cost is the walk to the first portal plus the steps between the portals taken
+    auto previousZone = startZone;
+    auto cost = 0.0f;
+    auto previousPortal = Map::noPortal;
+    for (auto zone : policy.path | std::views::reverse) {
+      auto const candidates = map.portals(previousZone);
+      auto best = std::numeric_limits<float>::infinity();
+      auto bestPortal = Map::noPortal;
+      for (auto const& portal : candidates) {
+        if (portal.to != zone) {
+          continue;
+        }
+        auto const step = previousPortal == Map::noPortal
+            ? map.portalField(portal.id).distance(grid.closestCell(start))
+            : map.portalField(portal.id).distance(map.portal(previousPortal).entry);
+        if (step < best) {
+          best = step;
+          bestPortal = portal.id;
+        }
+      }
+      ASSERT_NE(bestPortal, Map::noPortal);
+      cost += best;
+      previousPortal = bestPortal;
+      previousZone = zone;
+    }
+    ASSERT_NEAR(policy.cost, cost, 1e-2f);
+    ASSERT_LE(policy.path.size(), map.zoneCount());
+  }
+}
+
+TEST(MapTest, NavigationFileRoundTrip) {
+  auto const& compiled = dust2();
+  auto const navFilePath = (std::filesystem::temp_directory_path() / "MapTest.nav").string();
+  ASSERT_TRUE(compiled.save(navFilePath));
+  Map const loaded {navFilePath};
+
+  ASSERT_EQ(loaded.zoneCount(), compiled.zoneCount());
+  for (Map::ZoneId zone = 0; zone < compiled.zoneCount(); ++zone) {
+    ASSERT_EQ(loaded.zone(zone).name, compiled.zone(zone).name);
+    ASSERT_EQ(loaded.zone(zone).zone.volume, compiled.zone(zone).zone.volume);
+    ASSERT_EQ(loaded.zone(zone).zone.obstacles, compiled.zone(zone).zone.obstacles);
+    ASSERT_EQ(loaded.zone(zone).zone.hidingSpots, compiled.zone(zone).zone.hidingSpots);
+    ASSERT_TRUE(std::ranges::equal(loaded.watchpoints(zone), compiled.watchpoints(zone)));
+    ASSERT_EQ(loaded.transitions(zone).size(), compiled.transitions(zone).size());
+    ASSERT_EQ(loaded.portals(zone).size(), compiled.portals(zone).size());
+
+    auto const& grid = loaded.navigationGrid(zone);
+    ASSERT_EQ(grid.size(), compiled.navigationGrid(zone).size());
+    for (gabe::NavigationGrid::Cell cell = 0; cell < grid.size(); ++cell) {
+      ASSERT_EQ(grid.accessible(cell), compiled.navigationGrid(zone).accessible(cell));
+      ASSERT_EQ(loaded.sightlines(zone, cell).size(), compiled.sightlines(zone, cell).size());
+    }
+    for (Map::ZoneId target = 0; target < compiled.zoneCount(); ++target) {
+      ASSERT_EQ(loaded.nextHop(zone, target), compiled.nextHop(zone, target));
+      ASSERT_EQ(loaded.routeCost(zone, target), compiled.routeCost(zone, target));
+      auto const& field = loaded.flowField(target, zone);
+      ASSERT_EQ(field.size(), compiled.flowField(target, zone).size());
+      for (gabe::NavigationGrid::Cell cell = 0; cell < field.size(); cell += 7) {
+        ASSERT_EQ(field.waypoint(cell), compiled.flowField(target, zone).waypoint(cell));
+        ASSERT_EQ(field.distance(cell), compiled.flowField(target, zone).distance(cell));
+      }
+    }
+  }
+  for (Map::PortalId portal = 0; portal < compiled.portalCount(); ++portal) {
+    ASSERT_EQ(loaded.portal(portal).entry, compiled.portal(portal).entry);
+    ASSERT_EQ(loaded.portalSteps(portal).size(), compiled.portalSteps(portal).size());
+  }
+
+  Xoshiro256 generator {17};
+  std::uniform_real_distribution<float> xy {-2500.0f, 4500.0f};
+  for (Size idx = 0; idx < 2000; ++idx) {
+    Position const position {xy(generator), xy(generator), 100.0f};
+    ASSERT_EQ(loaded.findZoneId(position), compiled.findZoneId(position));
+  }
+  std::filesystem::remove(navFilePath);
+}
+
+//the navigation file the build compiled for the engine
+TEST(MapTest, BuiltNavigationFileMatchesDescription) {
+  auto const& compiled = dust2();
+  Map const built {GABE_MAPS_FOLDER "de_dust2.nav"};
+  ASSERT_EQ(built.zoneCount(), compiled.zoneCount());
+  ASSERT_EQ(built.portalCount(), compiled.portalCount());
+  for (Map::ZoneId zone = 0; zone < compiled.zoneCount(); ++zone) {
+    ASSERT_EQ(built.zone(zone).name, compiled.zone(zone).name);
+    ASSERT_EQ(built.findZoneId(compiled.zone(zone).zone.volume.center()), zone);
+    ASSERT_EQ(built.navigationGrid(zone).size(), compiled.navigationGrid(zone).size());
+  }
+}
+
+TEST(MapTest, RejectsDamagedNavigationFiles) {
+  auto const navFilePath = (std::filesystem::temp_directory_path() / "MapTestDamaged.nav").string();
+  ASSERT_TRUE(dust2().save(navFilePath));
+  std::filesystem::resize_file(navFilePath, std::filesystem::file_size(navFilePath) / 2);
+  ASSERT_THROW(Map {navFilePath}, gabe::exceptions::InvalidNavFileException);
+
+  std::ofstream {navFilePath, std::ios::binary} << "GABEREC1";
+  ASSERT_THROW(Map {navFilePath}, gabe::exceptions::InvalidNavFileException);
+  std::filesystem::remove(navFilePath);
+}
+
+TEST(MapTest, RejectsDamagedZoneIndexes) {
+  using Box = std::array<float, 6>;
+  auto const navFilePath = (std::filesystem::temp_directory_path() / "MapTestZoneIndex.nav").string();
+  //one zone of 100 by 100 in bounds of 120 by 120, cut in cells of 10
+  auto const readZoneIndex = [&navFilePath](Box const& bounds, float cellSize, Size cells) {
+    {
+      gabe::nav::Writer writer {navFilePath};
+      std::array<Box, 1> const boxes {Box {0.0f, 0.0f, 0.0f, 100.0f, 100.0f, 10.0f}};
+      writer.array(std::span<Box const> {boxes});
+      writer.value(bounds);
+      writer.value(cellSize);
+      writer.value(cells);
+      writer.value(cells);
+      std::vector<gabe::uint32> const cellOffsets(cells * cells + 1, 0);
+      writer.array(std::span<gabe::uint32 const> {cellOffsets});
+      writer.array(std::span<Map::ZoneId const> {});
+      writer.array(std::span<Map::ZoneId const> {std::array {Map::ZoneId {0}}});
+    }
+    gabe::utils::file::MappedFile const file {navFilePath};
+    gabe::nav::Reader reader {file.bytes(), navFilePath};
+    return gabe::ZoneIndex::read(reader).size();
+  };
+  Box const bounds {-10.0f, -10.0f, -10.0f, 110.0f, 110.0f, 20.0f};
+  ASSERT_EQ(readZoneIndex(bounds, 10.0f, 12), 1);
+  ASSERT_THROW(readZoneIndex(bounds, 0.0f, 12), gabe::exceptions::InvalidNavFileException);
+  ASSERT_THROW(readZoneIndex(bounds, -10.0f, 12), gabe::exceptions::InvalidNavFileException);
+  ASSERT_THROW(readZoneIndex(bounds, std::numeric_limits<float>::quiet_NaN(), 12),
+               gabe::exceptions::InvalidNavFileException);
+  ASSERT_THROW(readZoneIndex(bounds, 10.0f, 11), gabe::exceptions::InvalidNavFileException);
+  ASSERT_THROW(readZoneIndex({110.0f, -10.0f, -10.0f, -10.0f, 110.0f, 20.0f}, 10.0f, 12),
+               gabe::exceptions::InvalidNavFileException);
+  auto const infinity = std::numeric_limits<float>::infinity();
+  ASSERT_THROW(readZoneIndex({-10.0f, -10.0f, -10.0f, infinity, 110.0f, 20.0f}, 10.0f, 12),
+               gabe::exceptions::InvalidNavFileException);
+  std::filesystem::remove(navFilePath);
+}
+
+TEST(MapTest, DescriptionErrorsNameTheLine) {
+  ASSERT_THROW(gabe::parseMapDescription("zone T_SPAWN 0 0 0 1 1 1\nobstacle PIT 0 0 0 1 1 1\n"),
+               gabe::exceptions::InvalidMapDescriptionException);
+  try {
+    gabe::parseMapDescription("#comment\n\nzone T_SPAWN 0 0 0 1 1\n");
+    FAIL();
+  } catch (gabe::exceptions::InvalidMapDescriptionException const& e) {
+    ASSERT_EQ(std::string {e.what()}, "Map description line 3: expected a position");
+  }
+
+  auto const description = gabe::parseMapDescription("zone T_SPAWN 0 0 0 10 10 10\nzone PIT 10 0 0 20 10 10\n"
+                                                     "transition T_SPAWN PIT JUMP oneway 9 0 0 11 10 10\n"
+                                                     "watchpoint PIT T_SPAWN\n");
+  ASSERT_EQ(description.zones.size(), 2);
+  ASSERT_EQ(description.transitions.size(), 1);
+  ASSERT_TRUE(description.transitions[0].oneWay);
+  ASSERT_EQ(description.transitions[0].movement, Map::RequiredMovement::JUMP);
+  ASSERT_EQ(description.watchpoints[0].target, (Position {5.0f, 5.0f, 5.0f}));
+}
+
+TEST(MapTest, SightlinesAreVisibleWatchpoints) {
+  auto const& map = dust2();
+  std::vector<gabe::Volume> obstacles {};
+  for (Map::ZoneId zone = 0; zone < map.zoneCount(); ++zone) {
+    auto const& zoneObstacles = map.zone(zone).zone.obstacles;
+    obstacles.insert(obstacles.end(), zoneObstacles.begin(), zoneObstacles.end());
+  }
+  gabe::LineOfSight const lineOfSight {obstacles};
+
+  Size seen {0};
+  for (Map::ZoneId zone = 0; zone < map.zoneCount(); ++zone) {
+    auto const& grid = map.navigationGrid(zone);
+    for (gabe::NavigationGrid::Cell cell = 0; cell < grid.size(); ++cell) {
+      auto const sightlines = map.sightlines(zone, cell);
+      auto const watchpoints = map.watchpoints(zone);
+      ASSERT_EQ(sightlines.size(), std::ranges::count_if(watchpoints, [&](Position const& watchpoint) {
+                  return lineOfSight.visible(grid.center(cell), watchpoint);
+                }));
+      for (auto const& sightline : sightlines) {
+        ASSERT_NE(std::ranges::find(watchpoints, sightline.target), watchpoints.end());
+        ASSERT_LT(sightline.alias, sightlines.size());
+      }
+      seen += sightlines.size();
+    }
+  }
+  ASSERT_GT(seen, 0);
+
+  gabe::Volume const wall {{0.0f, -5.0f, 0.0f}, {10.0f, 5.0f, 0.0f}};
+  gabe::LineOfSight const blocked {std::span {&wall, 1}};
+  ASSERT_FALSE(blocked.visible({-20.0f, 0.0f, 0.0f}, {30.0f, 0.0f, 0.0f}));
+  ASSERT_TRUE(blocked.visible({-20.0f, 10.0f, 0.0f}, {30.0f, 10.0f, 0.0f}));
+  ASSERT_TRUE(blocked.visible({5.0f, 0.0f, 0.0f}, {30.0f, 0.0f, 0.0f}));
+}
+
+TEST(MapTest, WatchpointsAreSampledByPriority) {
+  Map const map {gabe::parseMapDescription("zone T_SPAWN 0 0 0 100 100 10\n"
+                                           "obstacle T_SPAWN 40 60 0 60 70 10\n"
+                                           "watchpoint T_SPAWN 100 50 5 3\n"
+                                           "watchpoint T_SPAWN 0 50 5\n"
+                                           "watchpoint T_SPAWN 50 100 5\n")};
+  auto const& grid = map.navigationGrid(0);
+  auto const cell = grid.closestCell({50.0f, 20.0f, 5.0f});
+  ASSERT_EQ(map.sightlines(0, cell).size(), 2);
+
+  Xoshiro256 generator {23};
+  Size right {0};
+  constexpr Size samples = 40000;
+  for (Size idx = 0; idx < samples; ++idx) {
+    auto const watchpoint = map.sampleWatchpoint(0, cell, generator);
+    ASSERT_TRUE(watchpoint.has_value());
+    ASSERT_NE(watchpoint->y, 100.0f);
+    right += watchpoint->x == 100.0f ? 1 : 0;
+  }
+  ASSERT_NEAR(static_cast<float>(right) / samples, 0.75f, 0.01f);
+}
@@ -0,0 +1,55 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "utils/random/AliasTable.hpp"
+#include "utils/random/Random.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+using gabe::Size;
+using gabe::utils::random::AliasTable;
+using gabe::utils::random::Xoshiro256;
+} // namespace
+
+TEST(RandomTest, AliasTableDistribution) {
+  std::array weights {0.5f, 0.0f, 0.3f, 0.2f};
+  AliasTable table {weights};
+  ASSERT_EQ(table.size(), weights.size());
+
+  Xoshiro256 generator {11};
+  constexpr Size sampleCount = 200000;
+  std::array<Size, 4> counts {};
+  for (Size idx = 0; idx < sampleCount; ++idx) {
+    ++counts[table.sample(generator)];
+  }
+  ASSERT_EQ(counts[1], 0);
+  for (Size idx = 0; idx < weights.size(); ++idx) {
+    ASSERT_NEAR(static_cast<double>(counts[idx]) / sampleCount, weights[idx], 0.01);
+  }
+}
+
+TEST(RandomTest, AliasTableRebuild) {
+  std::array first {1.0f, 0.0f};
+  std::array second {0.0f, 1.0f};
+  AliasTable table {first};
+  Xoshiro256 generator {5};
+  for (auto idx = 0; idx < 100; ++idx) {
+    ASSERT_EQ(table.sample(generator), 0);
+  }
+  table.rebuild(second);
+  for (auto idx = 0; idx < 100; ++idx) {
+    ASSERT_EQ(table.sample(generator), 1);
+  }
+}
+
+TEST(RandomTest, SeededStreams) {
+  gabe::utils::random::seedStreams(3);
+  auto first = gabe::utils::random::nextStream();
+  auto second = gabe::utils::random::nextStream();
+  gabe::utils::random::seedStreams(3);
+  auto replayed = gabe::utils::random::nextStream();
+  auto const value = first();
+  ASSERT_EQ(value, replayed());
+  ASSERT_NE(value, second());
+}
@@ -0,0 +1,122 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "replay/Recorder.hpp"
+#include "replay/Stepping.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+using gabe::replay::Entry;
+using gabe::replay::Recorder;
+using gabe::replay::Recording;
+using gabe::replay::Source;
+
+auto recordingPath() -> std::string { return std::filesystem::temp_directory_path() / "gabe_recording_test.bin"; }
+
+//what the tasks of a scheduler saw while a recording was stepped through it, one line per tick
+auto stepThroughRecording() -> std::vector<std::string> {
+  using namespace std::chrono_literals;
+  gabe::Scheduler scheduler {4};
+  std::string applied {};
+  std::vector<std::string> ticks {};
+  auto log = [&](std::string const& task) {
+    ticks.push_back(task + " " + std::to_string(scheduler.steppedTime().time_since_epoch().count()) + " " + applied);
+  };
+  scheduler.addTask("periodic", {3ms, 3ms}, [&] { log("periodic"); });
+  scheduler.addTask("woken", {1s, 1s, true}, [&] { log("woken"); });
+
+  Recording const recording {recordingPath()};
+  gabe::replay::stepThrough(recording, scheduler, [&](Entry const& entry) {
+    applied = entry.payload;
+    scheduler.notify();
+  });
+  return ticks;
+}
+} // namespace
+
+TEST(RecordingTest, RoundTrip) {
+  std::string const frame(1024, '\x7f');
+  {
+    Recorder recorder {recordingPath()};
+    recorder.record(Source::GAME_STATE, R"({"round": {"phase": "live"}})");
+    recorder.record(Source::POSITION, "setpos 1.0 2.0 3.0;setang 4.0 5.0 6.0");
+    recorder.record(Source::FRAME, frame);
+  }
+
+  Recording const recording {recordingPath()};
+  std::vector<Entry> entries {};
+  for (auto const entry : recording) {
+    entries.push_back(entry);
+  }
+  ASSERT_EQ(entries.size(), 3);
+  ASSERT_EQ(entries[0].source, Source::GAME_STATE);
+  ASSERT_EQ(entries[0].payload, R"({"round": {"phase": "live"}})");
+  ASSERT_EQ(entries[1].source, Source::POSITION);
+  ASSERT_EQ(entries[2].payload, frame);
+  ASSERT_LE(entries[0].offset, entries[1].offset);
+  ASSERT_LE(entries[1].offset, entries[2].offset);
+}
+
+TEST(RecordingTest, TruncatedEntryEndsRecording) {
+  {
+    Recorder recorder {recordingPath()};
+    recorder.record(Source::POSITION, "setpos 1.0 2.0 3.0;setang 4.0 5.0 6.0");
+    recorder.record(Source::FRAME, std::string(1024, '\x7f'));
+  }
+  std::filesystem::resize_file(recordingPath(), std::filesystem::file_size(recordingPath()) - 10);
+
+  Recording const recording {recordingPath()};
+  auto count = 0;
+  for (auto const entry : recording) {
+    ASSERT_EQ(entry.source, Source::POSITION);
+    ++count;
+  }
+  ASSERT_EQ(count, 1);
+}
+
+TEST(RecordingTest, RejectsOtherFiles) {
+  std::ofstream {recordingPath()} << "not a recording";
+  ASSERT_THROW(Recording {recordingPath()}, gabe::replay::exceptions::InvalidRecordingException);
+}
+
+TEST(RecordingTest, SteppedReplayIsDeterministic) {
+  {
+    Recorder recorder {recordingPath()};
+    for (auto idx = 0; idx < 5; ++idx) {
+      std::this_thread::sleep_for(std::chrono::milliseconds {2});
+      recorder.record(Source::POSITION, "setpos " + std::to_string(idx));
+    }
+  }
+
+  auto const first = stepThroughRecording();
+  auto const second = stepThroughRecording();
+  ASSERT_EQ(first, second);
+  //every entry wakes the notified task, and the periodic one ticks at least once per period of the recording
+  Recording const recording {recordingPath()};
+  gabe::Size entries = 0;
+  std::chrono::nanoseconds last {};
+  for (auto const entry : recording) {
+    ++entries;
+    last = entry.offset;
+  }
+  ASSERT_EQ(std::ranges::count_if(first, [](auto const& tick) { return tick.starts_with("woken"); }), entries + 1);
+  ASSERT_GE(std::ranges::count_if(first, [](auto const& tick) { return tick.starts_with("periodic"); }),
+            last / std::chrono::milliseconds {3});
+}
+
+TEST(RecordingTest, ShortWritesThrow) {
+  if (!std::filesystem::exists("/dev/full")) {
+    GTEST_SKIP();
+  }
+  Recorder recorder {"/dev/full"};
+  ASSERT_THROW(recorder.record(Source::FRAME, std::string(1 << 20, '\x7f')),
+               gabe::replay::exceptions::RecordingWriteException);
+}
@@ -0,0 +1,143 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "multithreaded/scheduler/Scheduler.hpp"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace std::chrono_literals;
+using gabe::ResourceAccess;
+using gabe::Scheduler;
+
+constexpr gabe::uint64 first = 1u << 0u;
+constexpr gabe::uint64 second = 1u << 1u;
+constexpr gabe::uint64 third = 1u << 2u;
+
+constexpr Scheduler::Timing timing {10ms, 10ms};
+} // namespace
+
+TEST(SchedulerTest, ConflictsFromAccessSets) {
+  static_assert(!ResourceAccess {first, 0}.conflictsWith({first, 0}));
+  static_assert(ResourceAccess {first, 0}.conflictsWith({0, first}));
+  static_assert(ResourceAccess {0, first}.conflictsWith({first, 0}));
+  static_assert(ResourceAccess {0, first}.conflictsWith({0, first}));
+  static_assert(!ResourceAccess {first, second}.conflictsWith({first, third}));
+  static_assert(!ResourceAccess {0, 0}.conflictsWith({}));
+  static_assert(ResourceAccess {}.conflictsWith({third, 0}));
+
+  constexpr auto merged = ResourceAccess {first, 0} | ResourceAccess {0, second};
+  static_assert(merged.reads == first && merged.writes == second);
+  static_assert(merged.conflictsWith({second, 0}) && !merged.conflictsWith({first, 0}));
+  SUCCEED();
+}
+
+//a task waits for every earlier added task it conflicts with, even when the conflicts would form a cycle
+TEST(SchedulerTest, ConflictingTasksRunInOrder) {
+  Scheduler scheduler {4};
+  std::mutex orderMutex {};
+  std::vector<std::string> order {};
+  auto task = [&](std::string const& name) {
+    return [&, name] {
+      std::this_thread::sleep_for(5ms);
+      std::lock_guard lockGuard {orderMutex};
+      order.push_back(name);
+    };
+  };
+  //each task conflicts with the next and the last with the first
+  scheduler.addTask("a", timing, task("a"), {second, first});
+  scheduler.addTask("b", timing, task("b"), {first, second});
+  scheduler.addTask("c", timing, task("c"), {second, third});
+  scheduler.addTask("d", timing, task("d"), {third, first});
+
+  ASSERT_EQ(scheduler.runOnce(), 4);
+  ASSERT_EQ(order, (std::vector<std::string> {"a", "b", "c", "d"}));
+}
+
+TEST(SchedulerTest, IndependentTasksRunConcurrently) {
+  Scheduler scheduler {4};
+  std::atomic<int> running {0};
+  std::atomic<int> overlapped {0};
+  //each task waits for the other to start, which only happens when both run at once
+  auto task = [&] {
+    ++running;
+    auto const giveUp = std::chrono::steady_clock::now() + 1s;
+    while (running.load() < 2 && std::chrono::steady_clock::now() < giveUp) {
+      std::this_thread::yield();
+    }
+    if (running.load() == 2) {
+      ++overlapped;
+    }
+  };
+  scheduler.addTask("first", timing, task, {first, first});
+  scheduler.addTask("second", timing, task, {second, second});
+
+  ASSERT_EQ(scheduler.runOnce(), 2);
+  ASSERT_EQ(overlapped.load(), 2);
+}
+
+TEST(SchedulerTest, TicksOncePerPeriod) {
+  Scheduler scheduler {};
+  std::vector<Scheduler::Clock::time_point> ticks {};
+  auto const added = Scheduler::Clock::now();
+  scheduler.addTask("periodic", {20ms, 20ms}, [&] { ticks.push_back(Scheduler::Clock::now()); });
+
+  for (auto idx = 0; idx < 3; ++idx) {
+    ASSERT_EQ(scheduler.runOnce(), 1);
+  }
+  ASSERT_EQ(ticks.size(), 3);
+  //the nth release is n periods after the task was added, however late the ones before it ran
+  for (gabe::Size idx = 0; idx < ticks.size(); ++idx) {
+    ASSERT_GE(ticks[idx] - added, idx * 20ms);
+  }
+  ASSERT_EQ(scheduler.statistics("periodic").ticks, 3);
+}
+
+TEST(SchedulerTest, SteppedTicksFollowReleases) {
+  Scheduler scheduler {};
+  std::vector<Scheduler::Clock::time_point> periodic {};
+  std::vector<Scheduler::Clock::time_point> woken {};
+  scheduler.addTask("periodic", {10ms, 10ms}, [&] { periodic.push_back(scheduler.steppedTime()); });
+  scheduler.addTask("woken", {1s, 1s, true}, [&] { woken.push_back(scheduler.steppedTime()); });
+
+  Scheduler::Clock::time_point const origin {};
+  ASSERT_EQ(scheduler.stepTo(origin), 2);
+  ASSERT_EQ(scheduler.stepTo(origin + 35ms), 3);
+  scheduler.notify();
+  ASSERT_EQ(scheduler.stepTo(origin + 35ms), 1);
+
+  ASSERT_EQ(periodic, (std::vector {origin, origin + 10ms, origin + 20ms, origin + 30ms}));
+  ASSERT_EQ(woken, (std::vector {origin, origin + 35ms}));
+}
+
+TEST(SchedulerTest, ClosedGateHoldsTasks) {
+  Scheduler scheduler {};
+  auto open = false;
+  auto ticks = 0;
+  scheduler.addTask("periodic", {10ms, 10ms}, [&] { ++ticks; });
+  scheduler.setGate([&] { return open; });
+
+  Scheduler::Clock::time_point const origin {};
+  ASSERT_EQ(scheduler.stepTo(origin + 50ms), 0);
+  open = true;
+  //releases held back by the gate are not caught up on
+  ASSERT_EQ(scheduler.stepTo(origin + 60ms), 1);
+  ASSERT_EQ(ticks, 1);
+}
+
+TEST(SchedulerTest, ExceptionsEndThePass) {
+  Scheduler scheduler {2};
+  auto ran = false;
+  scheduler.addTask("failing", timing, [] { throw std::runtime_error {"tick failed"}; }, {0, first});
+  scheduler.addTask("dependent", timing, [&ran] { ran = true; }, {first, 0});
+
+  ASSERT_THROW(scheduler.runOnce(), std::runtime_error);
+  ASSERT_TRUE(ran);
+}
@@ -0,0 +1,65 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "multithreaded/seqlock/SeqLock.hpp"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+namespace {
+using gabe::SeqLock;
+using gabe::uint64;
+
+struct Sample {
+  uint64 first {};
+  uint64 second {};
+  uint64 third {};
+  float fourth {};
+};
+} // namespace
+
+TEST(SeqLockTest, StoreAndLoad) {
+  SeqLock<Sample> lock {Sample {1, 2, 3, 4.0f}};
+  ASSERT_EQ(lock.load().third, 3);
+  auto const version = lock.version();
+  lock.modify([](Sample& sample) { sample.fourth = 5.0f; });
+  ASSERT_EQ(lock.load().first, 1);
+  ASSERT_EQ(lock.load().fourth, 5.0f);
+  ASSERT_EQ(lock.version(), version + 1);
+}
+
+TEST(SeqLockTest, ReadersNeverSeeTornValues) {
+  constexpr uint64 writeCount = 100000;
+  SeqLock<Sample> lock {};
+  std::atomic<bool> done {false};
+  std::atomic<uint64> tornReads {0};
+
+  std::vector<std::jthread> readers {};
+  for (auto idx = 0; idx < 3; ++idx) {
+    readers.emplace_back([&lock, &done, &tornReads] {
+      while (!done.load()) {
+        auto sample = lock.load();
+        if (sample.first != sample.second || sample.second != sample.third
+            || static_cast<float>(sample.first) != sample.fourth) {
+          ++tornReads;
+        }
+      }
+    });
+  }
+
+  std::vector<std::jthread> writers {};
+  for (uint64 writer = 0; writer < 2; ++writer) {
+    writers.emplace_back([&lock, writer] {
+      for (uint64 idx = writer; idx < writeCount; idx += 2) {
+        lock.store(Sample {idx, idx, idx, static_cast<float>(idx)});
+      }
+    });
+  }
+  writers.clear();
+  done = true;
+  readers.clear();
+
+  ASSERT_EQ(tornReads.load(), 0);
+  ASSERT_EQ(lock.version(), writeCount + 1);
+}
@@ -0,0 +1,65 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "multithreaded/threadPool/ThreadPool.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <atomic>
+#include <future>
+#include <latch>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+using gabe::Size;
+using gabe::ThreadPool;
+} // namespace
+
+TEST(ThreadPoolTest, ShutdownRunsPendingJobs) {
+  std::atomic<Size> ran {0};
+  {
+    ThreadPool pool {1};
+    std::latch release {1};
+    pool.submit([&release] { release.wait(); });
+    for (auto idx = 0; idx < 100; ++idx) {
+      pool.submit([&ran] { ++ran; });
+    }
+    //every job but the first is still queued when the pool starts shutting down
+    ASSERT_EQ(ran.load(), 0);
+    release.count_down();
+  }
+  ASSERT_EQ(ran.load(), 100);
+}
+
+TEST(ThreadPoolTest, ExceptionsReachTheFuture) {
+  ThreadPool pool {2};
+  auto failed = pool.submit([] { throw std::runtime_error {"job failed"}; });
+  ASSERT_THROW(failed.get(), std::runtime_error);
+
+  //the worker which ran the failed job keeps taking jobs
+  std::vector<std::future<void>> jobs {};
+  std::atomic<Size> ran {0};
+  for (auto idx = 0; idx < 10; ++idx) {
+    jobs.push_back(pool.submit([&ran] { ++ran; }));
+  }
+  for (auto& job : jobs) {
+    job.get();
+  }
+  ASSERT_EQ(ran.load(), 10);
+}
+
+TEST(ThreadPoolTest, EveryJobRunsOnce) {
+  static constexpr Size jobCount = 10000;
+  std::array<std::atomic<int>, jobCount> runs {};
+  {
+    ThreadPool pool {4};
+    ASSERT_EQ(pool.size(), 4);
+    for (Size idx = 0; idx < jobCount; ++idx) {
+      pool.submit([&runs, idx] { ++runs[idx]; });
+    }
+  }
+  for (auto const& count : runs) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
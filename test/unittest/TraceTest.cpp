@@ -0,0 +1,61 @@
+//
+// Created by stefan on 10/19/26.
+//
+
+#include "utils/trace/Histogram.hpp"
+#include "utils/trace/Trace.hpp"
+#include "gtest/gtest.h"
+#include <thread>
+
+namespace {
+using gabe::uint64;
+using gabe::utils::trace::Histogram;
+namespace trace = gabe::utils::trace;
+} // namespace
+
+TEST(TraceTest, HistogramPercentiles) {
+  Histogram<> histogram {};
+  for (uint64 value = 1; value <= 1000; ++value) {
+    histogram.record(value);
+  }
+  ASSERT_EQ(histogram.count(), 1000);
+  ASSERT_EQ(histogram.max(), 1000);
+  ASSERT_EQ(histogram.percentile(10), 100);
+  ASSERT_NEAR(histogram.percentile(50), 500, 500 / 64);
+  ASSERT_NEAR(histogram.percentile(99), 990, 990 / 64);
+  ASSERT_EQ(histogram.percentile(100), 1000);
+}
+
+TEST(TraceTest, HistogramLargeValues) {
+  Histogram<> histogram {};
+  histogram.record(~uint64 {0});
+  histogram.record(uint64 {1} << 40u);
+  ASSERT_NEAR(static_cast<double>(histogram.percentile(50)), static_cast<double>(uint64 {1} << 40u),
+              static_cast<double>(uint64 {1} << 34u));
+  ASSERT_EQ(histogram.percentile(100), ~uint64 {0});
+}
+
+TEST(TraceTest, SpansAreJoinedByFlow) {
+  auto const before = trace::Report {}.size();
+  trace::Span {"disabled", trace::Stage::SOLVE};
+  ASSERT_EQ(trace::Report {}.size(), before);
+
+  trace::enable();
+  std::jthread {[] {
+    trace::Span span {"capture", trace::Stage::CAPTURE};
+    span.setFlow(7);
+  }}.join();
+  trace::setFlow(7);
+  { trace::Span span {"decide", trace::Stage::EVALUATION}; }
+  ASSERT_EQ(trace::takeFlow(), 7);
+  { trace::Span span {"input", trace::Stage::SOLVE}; }
+  trace::record("input", trace::Stage::SOLVE, trace::ticks(), trace::ticks(), 7);
+  trace::enable(false);
+
+  trace::Report const report {};
+  ASSERT_EQ(report.size(), before + 4);
+  auto const summary = report.summary();
+  ASSERT_NE(summary.find("evaluation decide: 1 spans"), std::string::npos);
+  ASSERT_NE(summary.find("solve input: 2 spans"), std::string::npos);
+  ASSERT_NE(summary.find("capture to input: 1 spans"), std::string::npos);
+}